@@ -25,9 +25,19 @@
  * Output: 1
  */
 
+#include "simd_min.h"
+
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
 #include <iostream>
+#include <random>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -75,6 +85,162 @@ int findMinBinaryManual(const std::vector<int> &nums) {
   return nums[left];
 }
 
+// 4) Linear via SIMD kernels (AVX2/SSE4.1 with runtime dispatch)
+int findMinLinearSimd(const std::vector<int> &nums) {
+  return minOf(nums.data(), nums.size());
+}
+
+// 5) Batched binary search for many small arrays.
+//
+// The arrays are packed back to back in `values`; array i occupies
+// [offsets[i], offsets[i + 1]) and its minimum is written to out[i].
+//
+// Trailing copies of a[0] are trimmed first (the duplicate case above), after
+// which "a[j] >= a[0]" holds on a prefix and fails on the rest, so the
+// minimum sits right after the last index where it holds. That boundary is
+// found with a branchless search (the comparison only selects the next base),
+// and kGroup searches advance in lockstep with the next candidate probes
+// prefetched, so the cache misses of independent queries overlap instead of
+// stalling one after another.
+void findMinRotatedBatch(std::span<const int> values,
+                         std::span<const size_t> offsets, std::span<int> out) {
+  if (offsets.empty() || out.size() != offsets.size() - 1)
+    throw std::invalid_argument("offsets must hold out.size() + 1 entries.");
+  constexpr size_t kGroup = 16;
+
+  struct Search {
+    const int *first;
+    const int *base;
+    size_t len;
+  };
+  std::array<Search, kGroup> group;
+
+  for (size_t start = 0; start < out.size(); start += kGroup) {
+    const size_t count = std::min(kGroup, out.size() - start);
+    size_t active = 0;
+    for (size_t g = 0; g < count; ++g) {
+      size_t lo = offsets[start + g], hi = offsets[start + g + 1];
+      if (lo >= hi || hi > values.size())
+        throw std::invalid_argument("Array is empty.");
+      const int *a = values.data() + lo;
+      size_t last = hi - lo - 1;
+      while (last > 0 && a[last] == a[0])
+        --last;
+      group[g] = {a, a, last + 1};
+      active = std::max(active, last + 1);
+    }
+
+    while (active > 1) {
+      active = 0;
+      for (size_t g = 0; g < count; ++g) {
+        Search &q = group[g];
+        if (q.len <= 1)
+          continue;
+        size_t half = q.len / 2;
+        q.base = q.base[half] >= q.first[0] ? q.base + half : q.base;
+        q.len -= half;
+        __builtin_prefetch(q.base + q.len / 2);
+        __builtin_prefetch(q.base + q.len / 2 + q.len / 4);
+        active = std::max(active, q.len);
+      }
+    }
+
+    for (size_t g = 0; g < count; ++g) {
+      const Search &q = group[g];
+      size_t next = static_cast<size_t>(q.base - q.first) + 1;
+      size_t size = offsets[start + g + 1] - offsets[start + g];
+      // Without a descent the prefix covers everything: a[0] is the minimum.
+      out[start + g] = next < size && q.first[next] < q.first[0]
+                           ? q.first[next]
+                           : q.first[0];
+    }
+  }
+}
+
+// Single-array adapter so the batched search runs through runTests().
+int findMinBatchSingle(const std::vector<int> &nums) {
+  std::array<size_t, 2> offsets = {0, nums.size()};
+  int result = 0;
+  findMinRotatedBatch(nums, offsets, std::span<int>(&result, 1));
+  return result;
+}
+
+// Random rotated arrays (with many duplicates) packed CSR-style.
+struct RotatedBatch {
+  std::vector<int> values;
+  std::vector<size_t> offsets{0};
+};
+
+RotatedBatch makeRotatedBatch(size_t count, size_t maxLen, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<size_t> lenDist(1, maxLen);
+  std::uniform_int_distribution<int> valueDist(-50, 50);
+  RotatedBatch batch;
+  std::vector<int> arr;
+  for (size_t i = 0; i < count; ++i) {
+    arr.resize(lenDist(rng));
+    for (int &x : arr)
+      x = valueDist(rng);
+    std::sort(arr.begin(), arr.end());
+    std::rotate(arr.begin(), arr.begin() + rng() % arr.size(), arr.end());
+    batch.values.insert(batch.values.end(), arr.begin(), arr.end());
+    batch.offsets.push_back(batch.values.size());
+  }
+  return batch;
+}
+
+void testBatchRandom() {
+  std::cout << "=== Batched search vs binary (random) ===\n";
+  RotatedBatch batch = makeRotatedBatch(20000, 40, 11);
+  std::vector<int> got(batch.offsets.size() - 1);
+  findMinRotatedBatch(batch.values, batch.offsets, got);
+  for (size_t i = 0; i < got.size(); ++i) {
+    std::vector<int> arr(batch.values.begin() + batch.offsets[i],
+                         batch.values.begin() + batch.offsets[i + 1]);
+    assert(got[i] == findMinBinaryManual(arr));
+  }
+
+  bool threw = false;
+  std::vector<size_t> emptyOffsets = {0, 0};
+  try {
+    findMinRotatedBatch(batch.values, emptyOffsets, got);
+  } catch (const std::invalid_argument &) {
+    threw = true;
+  }
+  assert(threw);
+  std::cout << "Randomized checks passed.\n\n";
+}
+
+// Queries per second over many small arrays: one binary search at a time
+// versus the lockstep batch.
+void benchmarkBatch(size_t count) {
+  RotatedBatch batch = makeRotatedBatch(count, 64, 3);
+  std::vector<std::vector<int>> arrays;
+  arrays.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    arrays.emplace_back(batch.values.begin() + batch.offsets[i],
+                        batch.values.begin() + batch.offsets[i + 1]);
+  std::vector<int> out(count);
+
+  auto queriesPerSecond = [&](auto &&fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return static_cast<double>(count) /
+           std::chrono::duration<double>(t1 - t0).count() / 1e6;
+  };
+
+  std::cout << "=== Rotated minimum, " << count << " arrays (Mq/s) ===\n"
+            << std::fixed << std::setprecision(2);
+  std::cout << "  findMinBinaryManual  " << queriesPerSecond([&] {
+    for (size_t i = 0; i < count; ++i)
+      out[i] = findMinBinaryManual(arrays[i]);
+  }) << "\n";
+  std::cout << "  findMinRotatedBatch  " << queriesPerSecond([&] {
+    findMinRotatedBatch(batch.values, batch.offsets, out);
+  }) << "\n\n";
+}
+
 template <typename F>
 void runTests(const std::string &title, F algo,
               const std::vector<TestCase> &cases) {
@@ -104,6 +270,10 @@ int main() {
   runTests("Linear (by hand)", findMinLinearManual, cases);
   runTests("Linear (library: min_element)", findMinLinearLib, cases);
   runTests("Binary (by hand)", findMinBinaryManual, cases);
+  runTests("Linear (SIMD)", findMinLinearSimd, cases);
+  runTests("Batched binary (single)", findMinBatchSingle, cases);
+  testBatchRandom();
+  benchmarkBatch(200000);
 
   std::cout << "All tests passed successfully!\n";
   return 0;
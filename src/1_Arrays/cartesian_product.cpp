@@ -25,8 +25,18 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 // --- Recursive solution ---
@@ -72,6 +82,157 @@ cartesianProductIterative(const std::vector<std::vector<int>> &input) {
   return results;
 }
 
+// --- Lazy solution ---
+// A view of the product that never materializes it. Tuple number `index`
+// (in the same order as above: the last list varies fastest) is the
+// mixed-radix number whose digit i ranges over input[i].size(), so any tuple
+// can be decoded directly and the index space can be cut into contiguous
+// chunks for parallel enumeration. Iteration advances the digits like an
+// odometer and hands out the current tuple as a span into a buffer that is
+// reused for every step: memory stays O(number of lists) however large the
+// product is. The input must outlive the view, so temporaries are rejected.
+class CartesianProduct {
+public:
+  explicit CartesianProduct(const std::vector<std::vector<int>> &input)
+      : lists(input) {
+    for (const auto &list : lists) {
+      if (!list.empty() &&
+          total > std::numeric_limits<uint64_t>::max() / list.size())
+        throw std::overflow_error("Cartesian product exceeds 2^64 tuples.");
+      total *= list.size();
+    }
+  }
+
+  CartesianProduct(std::vector<std::vector<int>> &&) = delete;
+  CartesianProduct(const std::vector<std::vector<int>> &&) = delete;
+
+  // Number of tuples (1 for zero lists, 0 if any list is empty).
+  uint64_t size() const { return total; }
+
+  // Writes tuple number `index` into out (out.size() == number of lists).
+  void decode(uint64_t index, std::span<int> out) const {
+    if (index >= total)
+      throw std::out_of_range("Tuple index out of range.");
+    for (size_t i = lists.size(); i-- > 0;) {
+      out[i] = lists[i][index % lists[i].size()];
+      index /= lists[i].size();
+    }
+  }
+
+  // Input iterator: *it is a view of the shared tuple buffer, valid until
+  // the iterator is advanced.
+  class Iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::span<const int>;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::span<const int>;
+    using pointer = void;
+
+    Iterator() = default;
+
+    std::span<const int> operator*() const { return tuple; }
+    uint64_t index() const { return position; }
+
+    Iterator &operator++() {
+      ++position;
+      for (size_t i = digits.size(); i-- > 0;) {
+        const auto &list = (*lists)[i];
+        if (++digits[i] < list.size()) {
+          tuple[i] = list[digits[i]];
+          return *this;
+        }
+        digits[i] = 0;
+        tuple[i] = list[0];
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return position == other.position;
+    }
+
+  private:
+    friend class CartesianProduct;
+    Iterator(const std::vector<std::vector<int>> &lists, uint64_t position,
+             bool decodeTuple)
+        : lists(&lists), digits(lists.size()), tuple(lists.size()),
+          position(position) {
+      if (!decodeTuple)
+        return;
+      for (size_t i = lists.size(); i-- > 0;) {
+        digits[i] = position % lists[i].size();
+        tuple[i] = lists[i][digits[i]];
+        position /= lists[i].size();
+      }
+    }
+
+    const std::vector<std::vector<int>> *lists = nullptr;
+    std::vector<size_t> digits;
+    std::vector<int> tuple;
+    uint64_t position = 0;
+  };
+
+  Iterator begin() const { return at(0); }
+  Iterator end() const { return Iterator(lists, total, false); }
+
+  // Iterator positioned on tuple number `index` (index == size() is end()).
+  Iterator at(uint64_t index) const {
+    if (index > total)
+      throw std::out_of_range("Tuple index out of range.");
+    return Iterator(lists, index, index < total);
+  }
+
+  // Half-open index range of chunk `part` out of `parts` near-equal chunks.
+  std::pair<uint64_t, uint64_t> chunk(uint64_t part, uint64_t parts) const {
+    if (parts == 0 || part >= parts)
+      throw std::invalid_argument("Invalid chunk number.");
+    const uint64_t base = total / parts, extra = total % parts;
+    const uint64_t first = part * base + std::min(part, extra);
+    return {first, first + base + (part < extra ? 1 : 0)};
+  }
+
+  // Calls fn(index, tuple) for every tuple in [first, last).
+  template <typename Fn>
+  void forEach(uint64_t first, uint64_t last, Fn &&fn) const {
+    if (first >= last)
+      return;
+    for (Iterator it = at(first); it.index() < last; ++it)
+      fn(it.index(), *it);
+  }
+
+  // Enumerates everything on `threads` threads, one contiguous chunk each;
+  // fn(index, tuple) is called concurrently and must be thread-safe.
+  template <typename Fn> void forEachParallel(Fn fn, unsigned threads = 0) const {
+    if (threads == 0)
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    auto work = [&](unsigned t) {
+      auto [first, last] = chunk(t, threads);
+      forEach(first, last, fn);
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t)
+      pool.emplace_back(work, t);
+    work(0);
+    for (auto &thread : pool)
+      thread.join();
+  }
+
+private:
+  const std::vector<std::vector<int>> &lists;
+  uint64_t total = 1;
+};
+
+static_assert(std::input_iterator<CartesianProduct::Iterator>);
+static_assert(!std::is_constructible_v<CartesianProduct,
+                                       std::vector<std::vector<int>>>);
+
 // --- Test case struct ---
 struct TestCase {
   std::string name;
@@ -108,6 +269,154 @@ void testIterative(const std::vector<TestCase> &cases) {
   std::cout << "\n";
 }
 
+void testLazy(const std::vector<TestCase> &cases) {
+  std::cout << "=== Testing CartesianProduct (lazy) ===\n";
+  for (auto &tc : cases) {
+    CartesianProduct product(tc.input);
+    std::vector<std::vector<int>> got;
+    for (std::span<const int> tuple : product)
+      got.emplace_back(tuple.begin(), tuple.end());
+    // Lazy order matches the iterative order exactly.
+    bool pass = got == cartesianProductIterative(tc.input) &&
+                product.size() == got.size();
+    std::vector<int> decoded(tc.input.size());
+    for (uint64_t i = 0; pass && i < product.size(); ++i) {
+      product.decode(i, decoded);
+      auto it = product.at(i);
+      pass = decoded == got[i] &&
+             std::equal((*it).begin(), (*it).end(), got[i].begin());
+    }
+    std::cout << tc.name << " -> " << (pass ? "PASS" : "FAIL") << "\n";
+    assert(pass);
+  }
+
+  // Works with <algorithm>: tuples summing to 6 in {1,2,3}^3.
+  std::vector<std::vector<int>> dice(3, {1, 2, 3});
+  CartesianProduct rolls(dice);
+  auto sumsTo = [](int target) {
+    return [target](std::span<const int> t) {
+      return t[0] + t[1] + t[2] == target;
+    };
+  };
+  const auto sixes = std::count_if(rolls.begin(), rolls.end(), sumsTo(6));
+  const auto firstNine = std::find_if(rolls.begin(), rolls.end(), sumsTo(9));
+  bool algorithms = sixes == 7 && firstNine.index() == 26 &&
+                    std::distance(rolls.begin(), rolls.end()) == 27;
+  std::cout << "Standard algorithms -> " << (algorithms ? "PASS" : "FAIL")
+            << "\n";
+  assert(algorithms);
+
+  std::vector<std::vector<int>> withEmpty = {{1, 2}, {}, {3}};
+  CartesianProduct empty(withEmpty);
+  bool pass = empty.size() == 0 && empty.begin() == empty.end();
+  std::cout << "Empty inner list -> " << (pass ? "PASS" : "FAIL") << "\n";
+  assert(pass);
+
+  std::vector<std::vector<int>> huge(64, {0, 1, 2});
+  bool threw = false;
+  try {
+    CartesianProduct tooLarge(huge);
+  } catch (const std::overflow_error &) {
+    threw = true;
+  }
+  std::cout << "Overflowing size throws -> " << (threw ? "PASS" : "FAIL")
+            << "\n\n";
+  assert(threw);
+}
+
+// Chunks tile the index space and parallel enumeration visits every tuple
+// exactly once.
+void testLazyChunks() {
+  std::cout << "=== Testing CartesianProduct chunks ===\n";
+  std::vector<std::vector<int>> input(8, {0, 1, 2, 3}); // 4^8 tuples
+  CartesianProduct product(input);
+  for (uint64_t parts : {1, 3, 7, 100000}) {
+    uint64_t expectedFirst = 0;
+    for (uint64_t p = 0; p < parts; ++p) {
+      auto [first, last] = product.chunk(p, parts);
+      assert(first == expectedFirst && first <= last);
+      expectedFirst = last;
+    }
+    assert(expectedFirst == product.size());
+  }
+
+  for (unsigned threads : {1u, 3u, 8u}) {
+    // Each tuple, read as base-4 digits, must equal its own index.
+    std::vector<char> seen(product.size(), 0);
+    product.forEachParallel(
+        [&](uint64_t index, std::span<const int> tuple) {
+          uint64_t value = 0;
+          for (int digit : tuple)
+            value = value * 4 + digit;
+          assert(value == index);
+          seen[index] = 1;
+        },
+        threads);
+    bool pass = std::all_of(seen.begin(), seen.end(), [](char c) { return c; });
+    std::cout << "threads=" << threads << " -> " << (pass ? "PASS" : "FAIL")
+              << "\n";
+    assert(pass);
+  }
+  std::cout << "\n";
+}
+
+// 10 lists of 10 digits: 10^10 tuples, enumerated from the middle with O(10)
+// memory.
+void demoHugeSpace() {
+  std::vector<int> digits = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<std::vector<int>> input(10, digits);
+  CartesianProduct product(input);
+  auto [first, last] = product.chunk(3, 7);
+  std::vector<int> tuple(input.size());
+  product.decode(first, tuple);
+  uint64_t value = 0;
+  for (int d : tuple)
+    value = value * 10 + d;
+  assert(product.size() == 10000000000ull && value == first);
+
+  uint64_t visited = 0;
+  product.forEach(first, first + 1000000,
+                  [&](uint64_t, std::span<const int>) { ++visited; });
+  assert(visited == 1000000);
+  std::cout << "10^10 space: chunk 3/7 is [" << first << ", " << last
+            << "), first 10^6 tuples enumerated\n\n";
+}
+
+// Tuples per second: materializing everything versus the lazy view.
+void benchmarkProduct() {
+  std::vector<std::vector<int>> input(7, {1, 2, 3, 4, 5, 6}); // 6^7 tuples
+  const double tuples = 279936.0;
+
+  auto mTuplesPerSecond = [&](auto &&fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    volatile long long sink = fn();
+    (void)sink;
+    auto t1 = std::chrono::steady_clock::now();
+    return tuples / std::chrono::duration<double>(t1 - t0).count() / 1e6;
+  };
+  auto checksum = [](const std::vector<std::vector<int>> &all) {
+    long long sum = 0;
+    for (const auto &t : all)
+      sum += t.back();
+    return sum;
+  };
+
+  std::cout << "=== 6^7 tuples (M tuples/s) ===\n" << std::fixed
+            << std::setprecision(2);
+  std::cout << "  recursive  " << mTuplesPerSecond([&] {
+    return checksum(cartesianProductRecursive(input));
+  }) << "\n";
+  std::cout << "  iterative  " << mTuplesPerSecond([&] {
+    return checksum(cartesianProductIterative(input));
+  }) << "\n";
+  std::cout << "  lazy       " << mTuplesPerSecond([&] {
+    long long sum = 0;
+    for (std::span<const int> tuple : CartesianProduct(input))
+      sum += tuple.back();
+    return sum;
+  }) << "\n\n";
+}
+
 int main() {
   std::vector<TestCase> cases = {
       {"3×2×2 grid",
@@ -126,6 +435,10 @@ int main() {
 
   testRecursive(cases);
   testIterative(cases);
+  testLazy(cases);
+  testLazyChunks();
+  demoHugeSpace();
+  benchmarkProduct();
 
   std::cout << "All tests passed successfully!\n";
   return 0;
@@ -11,11 +11,23 @@
  *   - Elements: [5, 3]
  */
 
+#include "flat_counter.h"
+
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <functional>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -51,27 +63,328 @@ int countDuplicatesSet(const std::vector<int> &arr) {
   return duplicates.size();
 }
 
+// Dense-range path: when [min, max] is small, two bitsets indexed by
+// value - min record "seen" and "duplicated". O(n + span) time, 2 bits per
+// value in the range.
+std::vector<int> findDuplicatesDense(const std::vector<int> &arr, int min,
+                                     int max) {
+  const size_t span = static_cast<size_t>(static_cast<int64_t>(max) - min) + 1;
+  std::vector<uint64_t> seen((span + 63) / 64, 0);
+  std::vector<uint64_t> repeated((span + 63) / 64, 0);
+  for (int x : arr) {
+    size_t offset = static_cast<size_t>(static_cast<int64_t>(x) - min);
+    uint64_t bit = uint64_t{1} << (offset & 63);
+    repeated[offset >> 6] |= seen[offset >> 6] & bit;
+    seen[offset >> 6] |= bit;
+  }
+  std::vector<int> duplicates;
+  for (size_t word = 0; word < repeated.size(); ++word) {
+    for (uint64_t bits = repeated[word]; bits; bits &= bits - 1) {
+      size_t offset = word * 64 + std::countr_zero(bits);
+      duplicates.push_back(static_cast<int>(min + static_cast<int64_t>(offset)));
+    }
+  }
+  return duplicates;
+}
+
+// Sparse path: flat open-addressing counter (see flat_counter.h).
+std::vector<int> findDuplicatesFlat(const std::vector<int> &arr) {
+  FlatIntCounter freq(std::min<size_t>(arr.size(), 1 << 16));
+  for (int x : arr)
+    freq.increment(x);
+  std::vector<int> duplicates;
+  freq.forEach([&](int key, uint32_t count) {
+    if (count > 1)
+      duplicates.push_back(key);
+  });
+  return duplicates;
+}
+
 // Optimal Solution (O(n) using hashing)
+// Picks the bitset path for small value ranges and the flat counter
+// otherwise.
 int countDuplicatesOptimal(const std::vector<int> &arr) {
-  std::unordered_map<int, int> freq;
+  if (arr.empty())
+    return 0;
+  auto [min, max] = valueRange(arr);
+  if (isDenseRange(min, max, arr.size()))
+    return static_cast<int>(findDuplicatesDense(arr, min, max).size());
+
+  FlatIntCounter freq(std::min<size_t>(arr.size(), 1 << 16));
   for (int x : arr)
-    freq[x]++;
+    freq.increment(x);
   int duplicates = 0;
-  for (auto &[key, val] : freq)
-    if (val > 1)
+  freq.forEach([&](int, uint32_t count) {
+    if (count > 1)
       ++duplicates;
+  });
   return duplicates;
 }
 
 // Optimal solution to return duplicate elements (O(n))
 std::vector<int> findDuplicatesOptimal(const std::vector<int> &arr) {
+  if (arr.empty())
+    return {};
+  auto [min, max] = valueRange(arr);
+  if (isDenseRange(min, max, arr.size()))
+    return findDuplicatesDense(arr, min, max);
+  return findDuplicatesFlat(arr);
+}
+
+// Parallel Sharded Solution
+// For arrays far larger than cache a single table thrashes: every increment
+// is a cache miss. Instead the input is radix-partitioned by a hash of the
+// value into shards small enough that each shard's FlatIntCounter fits in
+// L2, and shards are then counted independently:
+//   1. each thread histograms its slice by shard,
+//   2. prefix sums give every (thread, shard) pair its own output range,
+//   3. each thread scatters its slice (no synchronization needed),
+//   4. threads claim whole shards, count them and keep the duplicates.
+// Equal values always land in the same shard, so per-shard duplicate lists
+// are simply concatenated.
+// Time: O(n / T + shards), Space: O(n) for the partitioned copy.
+struct DuplicateReport {
+  size_t count = 0;
+  std::vector<int> keys;
+  size_t peakTableBytes = 0; // largest shard counting table
+};
+
+namespace sharding {
+// A mixer independent of FlatIntCounter's multiplicative hash, so the
+// shard bits do not correlate with slot bits inside a shard.
+inline uint32_t mix(int value) {
+  uint32_t h = static_cast<uint32_t>(value);
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+  return h;
+}
+
+// Aim for ~16K keys per shard: a 32K-slot table of 8-byte slots is 256 KiB.
+inline size_t shardCountFor(size_t n) {
+  return std::clamp<size_t>(std::bit_ceil(n / 16384 + 1), 1, 1 << 16);
+}
+} // namespace sharding
+
+DuplicateReport findDuplicatesParallel(const std::vector<int> &arr,
+                                       unsigned threads = 0) {
+  DuplicateReport report;
+  const size_t n = arr.size();
+  if (n == 0)
+    return report;
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+
+  const size_t shards = sharding::shardCountFor(n);
+  const size_t mask = shards - 1;
+  const size_t chunk = (n + threads - 1) / threads;
+  auto runOnThreads = [threads](auto &&body) {
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t)
+      pool.emplace_back(body, t);
+    body(0u);
+    for (auto &thread : pool)
+      thread.join();
+  };
+
+  // 1. Histogram per thread: histogram[t * shards + s].
+  std::vector<size_t> histogram(threads * shards, 0);
+  runOnThreads([&](unsigned t) {
+    const size_t begin = std::min(n, t * chunk);
+    const size_t end = std::min(n, begin + chunk);
+    size_t *counts = histogram.data() + t * shards;
+    for (size_t i = begin; i < end; ++i)
+      ++counts[sharding::mix(arr[i]) & mask];
+  });
+
+  // 2. Exclusive prefix sum in shard-major order.
+  std::vector<size_t> shardStart(shards + 1, 0);
+  std::vector<size_t> cursor(threads * shards);
+  size_t offset = 0;
+  for (size_t s = 0; s < shards; ++s) {
+    shardStart[s] = offset;
+    for (unsigned t = 0; t < threads; ++t) {
+      cursor[t * shards + s] = offset;
+      offset += histogram[t * shards + s];
+    }
+  }
+  shardStart[shards] = offset;
+
+  // 3. Scatter into the partitioned copy.
+  std::vector<int> partitioned(n);
+  runOnThreads([&](unsigned t) {
+    const size_t begin = std::min(n, t * chunk);
+    const size_t end = std::min(n, begin + chunk);
+    size_t *out = cursor.data() + t * shards;
+    for (size_t i = begin; i < end; ++i)
+      partitioned[out[sharding::mix(arr[i]) & mask]++] = arr[i];
+  });
+
+  // 4. Count shards independently; threads claim shards dynamically. Tables
+  // are sized for the expected distinct keys per shard, not the shard's
+  // length: a value repeated a billion times lands in one shard but needs
+  // one slot. Shards with more distinct keys grow their table.
+  std::vector<std::vector<int>> perShard(shards);
+  std::vector<size_t> tableBytes(threads, 0);
+  const size_t expectedKeys = n / shards + 1;
+  std::atomic<size_t> nextShard{0};
+  runOnThreads([&](unsigned t) {
+    FlatIntCounter freq;
+    for (size_t s = nextShard++; s < shards; s = nextShard++) {
+      freq.clear();
+      freq.reserve(std::min(shardStart[s + 1] - shardStart[s], expectedKeys));
+      for (size_t i = shardStart[s]; i < shardStart[s + 1]; ++i)
+        freq.increment(partitioned[i]);
+      freq.forEach([&](int key, uint32_t count) {
+        if (count > 1)
+          perShard[s].push_back(key);
+      });
+    }
+    tableBytes[t] = freq.memoryBytes();
+  });
+  report.peakTableBytes =
+      *std::max_element(tableBytes.begin(), tableBytes.end());
+
+  for (const auto &keys : perShard)
+    report.count += keys.size();
+  report.keys.reserve(report.count);
+  for (const auto &keys : perShard)
+    report.keys.insert(report.keys.end(), keys.begin(), keys.end());
+  return report;
+}
+
+// Streaming Solution with Bounded Memory
+// countDuplicatesSet remembers every value, so memory grows with the stream.
+// This detector consumes values one at a time within a fixed budget:
+// - a Bloom filter (m bits, k hash probes) answers "maybe seen before";
+//   it has no false negatives,
+// - an exact tier (FlatIntCounter reserved to a fixed capacity) remembers
+//   the first `exactCapacity` distinct values and confirms duplicates.
+// While the exact tier has room it holds every distinct value seen so far,
+// so a Bloom hit that misses the tier is a false positive and is discarded.
+// Once the tier is full, such hits are reported as possible duplicates.
+//
+// Bloom false-positive rate after n distinct values is about
+// (1 - e^(-k n / m))^k, minimized by k = (m / n) ln 2:
+//   bits per value    4      8      10     16
+//   best k            3      6      7      11
+//   FP rate           14.7%  2.2%   0.82%  0.046%
+// Time: O(k) per value, Space: m / 8 bytes + 8 bytes per exact-tier slot.
+class StreamingDuplicateDetector {
+public:
+  enum class Outcome { First, Possible, Confirmed };
+
+  struct Stats {
+    size_t observed = 0;
+    size_t possible = 0;  // Bloom hit, not verifiable by the exact tier
+    size_t confirmed = 0; // repeated occurrences verified exactly
+    size_t confirmedKeys = 0;
+  };
+
+  StreamingDuplicateDetector(size_t bloomBits, unsigned hashes,
+                             size_t exactCapacity)
+      : bits((std::max<size_t>(bloomBits, 64) + 63) / 64, 0),
+        numBits(bits.size() * 64), hashes(std::max(1u, hashes)),
+        exactCapacity(exactCapacity), exact(exactCapacity) {}
+
+  // Splits a byte budget: up to a quarter goes to the exact tier (8 bytes per
+  // table slot, at most 2/3 of the slots used), the rest to a Bloom filter
+  // with the best k for `expectedDistinct` values.
+  static StreamingDuplicateDetector forBudget(size_t bytes,
+                                              size_t expectedDistinct) {
+    const size_t tableSlots = std::bit_floor(std::max<size_t>(bytes / 32, 16));
+    const size_t exactSlots = tableSlots * 2 / 3 - 1;
+    const size_t bloomBits = (bytes - std::min(bytes, tableSlots * 8)) * 8;
+    const double bitsPerValue = static_cast<double>(bloomBits) /
+                                std::max<size_t>(expectedDistinct, 1);
+    const unsigned k = static_cast<unsigned>(
+        std::clamp(std::round(bitsPerValue * std::log(2.0)), 1.0, 16.0));
+    return StreamingDuplicateDetector(bloomBits, k, exactSlots);
+  }
+
+  static double expectedFalsePositiveRate(size_t bloomBits, unsigned hashes,
+                                          size_t distinct) {
+    double fill = 1.0 - std::exp(-static_cast<double>(hashes) *
+                                 static_cast<double>(distinct) /
+                                 static_cast<double>(bloomBits));
+    return std::pow(fill, hashes);
+  }
+
+  Outcome observe(int value) {
+    ++stats.observed;
+    const uint64_t h = splitmix(static_cast<uint32_t>(value));
+    const uint64_t h1 = h & 0xFFFFFFFFu;
+    const uint64_t h2 = (h >> 32) | 1;
+    bool allSet = true;
+    for (unsigned i = 0; i < hashes; ++i) {
+      const uint64_t bit = (h1 + i * h2) % numBits;
+      const uint64_t word = bits[bit >> 6];
+      const uint64_t flag = uint64_t{1} << (bit & 63);
+      allSet = allSet && (word & flag);
+      bits[bit >> 6] = word | flag;
+    }
+
+    if (exact.count(value) != 0) {
+      ++stats.confirmed;
+      if (exact.increment(value) == 2)
+        ++stats.confirmedKeys;
+      return Outcome::Confirmed;
+    }
+    if (exact.size() < exactCapacity) {
+      exact.increment(value); // tier still complete: any Bloom hit was false
+      return Outcome::First;
+    }
+    if (allSet) {
+      ++stats.possible;
+      return Outcome::Possible;
+    }
+    return Outcome::First;
+  }
+
+  template <typename InputIt> void ingest(InputIt first, InputIt last) {
+    for (; first != last; ++first)
+      observe(*first);
+  }
+
+  // Reads whitespace-separated integers, e.g. from a file of event IDs.
+  void ingest(std::istream &in) {
+    ingest(std::istream_iterator<int>(in), std::istream_iterator<int>());
+  }
+
+  const Stats &statistics() const { return stats; }
+  size_t bloomBits() const { return numBits; }
+  unsigned hashCount() const { return hashes; }
+  size_t memoryBytes() const {
+    return bits.size() * sizeof(uint64_t) + exact.memoryBytes();
+  }
+
+private:
+  static uint64_t splitmix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+  }
+
+  std::vector<uint64_t> bits;
+  uint64_t numBits; // not a power of two in general, hence %
+  unsigned hashes;
+  size_t exactCapacity;
+  FlatIntCounter exact;
+  Stats stats;
+};
+
+// Node-based hash map version, kept as the benchmark baseline.
+int countDuplicatesHashMap(const std::vector<int> &arr) {
   std::unordered_map<int, int> freq;
   for (int x : arr)
     freq[x]++;
-  std::vector<int> duplicates;
+  int duplicates = 0;
   for (auto &[key, val] : freq)
     if (val > 1)
-      duplicates.push_back(key);
+      ++duplicates;
   return duplicates;
 }
 
@@ -131,6 +444,106 @@ void runTests(const std::string &title, const std::vector<TestCase> &cases,
   std::cout << "\n";
 }
 
+// --- Benchmark ---
+// ns/element for the node-based map, the flat counter and the dense path on
+// inputs of varying cardinality. Pass a larger n (e.g. 10^8) for
+// production-sized inputs.
+void benchmarkDuplicateCounting(size_t n) {
+  std::mt19937 rng(11);
+  std::cout << "=== Duplicate counting, n=" << n << " (ns/element) ===\n";
+  std::cout << std::left << std::setw(14) << "cardinality" << std::setw(12)
+            << "hash map" << std::setw(12) << "flat" << std::setw(12)
+            << "dense" << "\n";
+  for (size_t cardinality : {size_t{16}, size_t{1000}, n / 10, n}) {
+    std::uniform_int_distribution<int> dist(0, static_cast<int>(cardinality));
+    std::vector<int> arr(n);
+    for (auto &v : arr)
+      v = dist(rng);
+
+    auto nsPerElement = [&](auto &&fn) {
+      auto t0 = std::chrono::steady_clock::now();
+      volatile size_t sink = fn();
+      (void)sink;
+      auto t1 = std::chrono::steady_clock::now();
+      return std::chrono::duration<double, std::nano>(t1 - t0).count() /
+             static_cast<double>(n);
+    };
+    auto [min, max] = valueRange(arr);
+    std::cout << std::left << std::fixed << std::setprecision(2)
+              << std::setw(14) << cardinality << std::setw(12)
+              << nsPerElement([&] { return countDuplicatesHashMap(arr); })
+              << std::setw(12)
+              << nsPerElement([&] { return findDuplicatesFlat(arr).size(); })
+              << std::setw(12) << nsPerElement([&] {
+                   return findDuplicatesDense(arr, min, max).size();
+                 })
+              << "\n";
+  }
+  std::cout << "\n";
+}
+
+// Thread scaling of the sharded engine. Pass n = 10^9 for production-sized
+// runs.
+void benchmarkParallelDuplicates(size_t n,
+                                 const std::vector<unsigned> &threadCounts) {
+  std::mt19937 rng(23);
+  std::uniform_int_distribution<int> dist(0, static_cast<int>(n));
+  std::vector<int> arr(n);
+  for (auto &v : arr)
+    v = dist(rng);
+
+  std::cout << "=== Sharded duplicates, n=" << n << " ("
+            << sharding::shardCountFor(n) << " shards) ===\n";
+  double baseline = 0.0;
+  for (unsigned threads : threadCounts) {
+    auto t0 = std::chrono::steady_clock::now();
+    DuplicateReport report = findDuplicatesParallel(arr, threads);
+    auto t1 = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    if (baseline == 0.0)
+      baseline = seconds;
+    std::cout << "  threads=" << std::setw(3) << threads << "  " << std::fixed
+              << std::setprecision(1) << n / seconds / 1e6 << " Melem/s"
+              << "  speedup " << std::setprecision(2) << baseline / seconds
+              << "  duplicates=" << report.count << "\n";
+  }
+  std::cout << "\n";
+}
+
+// Ingest throughput and accuracy of the streaming detector for several
+// memory budgets, on a stream of n event IDs of which ~40% repeat.
+void benchmarkStreamingDuplicates(size_t n) {
+  std::mt19937 rng(31);
+  std::uniform_int_distribution<int> dist(0, static_cast<int>(n));
+  std::vector<int> stream(n);
+  for (auto &v : stream)
+    v = dist(rng);
+  const size_t distinct = std::unordered_set<int>(stream.begin(), stream.end())
+                              .size();
+
+  std::cout << "=== Streaming duplicates, n=" << n << ", distinct="
+            << distinct << " ===\n";
+  for (size_t budget : {size_t{256} << 10, size_t{1} << 20, size_t{4} << 20}) {
+    auto detector = StreamingDuplicateDetector::forBudget(budget, distinct);
+    auto t0 = std::chrono::steady_clock::now();
+    detector.ingest(stream.begin(), stream.end());
+    auto t1 = std::chrono::steady_clock::now();
+    const auto &stats = detector.statistics();
+    std::cout << "  budget " << std::setw(5) << (budget >> 10) << " KiB"
+              << "  used " << std::setw(5) << (detector.memoryBytes() >> 10)
+              << " KiB  k=" << detector.hashCount() << "  " << std::fixed
+              << std::setprecision(1)
+              << n / std::chrono::duration<double>(t1 - t0).count() / 1e6
+              << " Mvalues/s  confirmed=" << stats.confirmed
+              << " possible=" << stats.possible << " expectedFP="
+              << std::setprecision(4)
+              << StreamingDuplicateDetector::expectedFalsePositiveRate(
+                     detector.bloomBits(), detector.hashCount(), distinct)
+              << "\n";
+  }
+  std::cout << "\n";
+}
+
 // --- Example usage ---
 
 int main() {
@@ -139,14 +552,21 @@ int main() {
       {"Two pairs", {5, 10, 15, 5, 3, 3}, 2},
       {"Overlapping dups", {3, 9, 9, 7, 3}, 2},
       {"All same", {8, 8, 8, 8}, 1},
-      {"Single element", {42}, 0}};
+      {"Single element", {42}, 0},
+      {"Sparse range", {-2000000000, 7, 2000000000, 7, -2000000000}, 2},
+      {"Extreme values",
+       {INT32_MIN, INT32_MAX, INT32_MIN, 0, INT32_MAX, INT32_MAX},
+       2}};
 
   std::vector<TestCaseList> listCases = {
       {"No duplicates", {1, 2, 3, 4, 5}, {}},
       {"Two values", {5, 10, 15, 5, 3, 3}, {3, 5}},
       {"Two values", {3, 9, 9, 7, 3}, {3, 9}},
       {"All same", {8, 8, 8, 8}, {8}},
-      {"Single element", {42}, {}}};
+      {"Single element", {42}, {}},
+      {"Sparse range", {-2000000000, 7, 2000000000, 7, -2000000000},
+       {-2000000000, 7}},
+      {"Empty", {}, {}}};
 
   runTests(
       "Testing countDuplicatesSimple", countCases, countDuplicatesSimple,
@@ -168,6 +588,153 @@ int main() {
       [](auto &tc) { return tc.expectedList; },
       [](auto v) { return vecToStr(v); });
 
+  runTests(
+      "Testing countDuplicatesHashMap", countCases, countDuplicatesHashMap,
+      [](auto &tc) { return tc.expectedCount; },
+      [](auto v) { return std::to_string(v); });
+
+  runTests(
+      "Testing findDuplicatesFlat", listCases, findDuplicatesFlat,
+      [](auto &tc) { return tc.expectedList; },
+      [](auto v) { return vecToStr(v); });
+
+  // Flat and dense paths agree with the hash map on random data.
+  {
+    std::mt19937 rng(5);
+    for (int cardinality : {10, 1000, 100000}) {
+      std::uniform_int_distribution<int> dist(0, cardinality - 1);
+      std::vector<int> arr(50000);
+      for (auto &v : arr)
+        v = dist(rng);
+      auto dense = findDuplicatesDense(arr, 0, cardinality - 1);
+      auto flat = findDuplicatesFlat(arr);
+      std::sort(flat.begin(), flat.end());
+      bool pass = dense == flat && static_cast<int>(dense.size()) ==
+                                       countDuplicatesHashMap(arr);
+      std::cout << "Random cardinality " << cardinality << " -> "
+                << (pass ? "PASS" : "FAIL") << "\n";
+      assert(pass);
+    }
+    std::cout << "\n";
+  }
+
+  runTests(
+      "Testing findDuplicatesParallel (keys)", listCases,
+      [](const std::vector<int> &arr) {
+        return findDuplicatesParallel(arr, 3).keys;
+      },
+      [](auto &tc) { return tc.expectedList; },
+      [](auto v) { return vecToStr(v); });
+
+  runTests(
+      "Testing findDuplicatesParallel (count)", countCases,
+      [](const std::vector<int> &arr) {
+        return static_cast<int>(findDuplicatesParallel(arr, 2).count);
+      },
+      [](auto &tc) { return tc.expectedCount; },
+      [](auto v) { return std::to_string(v); });
+
+  // Parallel engine agrees with the flat counter on a multi-shard input.
+  {
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> dist(-300000, 300000);
+    std::vector<int> arr(400000);
+    for (auto &v : arr)
+      v = dist(rng);
+    auto expected = findDuplicatesFlat(arr);
+    std::sort(expected.begin(), expected.end());
+    bool pass = true;
+    for (unsigned threads : {1u, 4u, 7u}) {
+      DuplicateReport report = findDuplicatesParallel(arr, threads);
+      std::sort(report.keys.begin(), report.keys.end());
+      pass = pass && report.keys == expected &&
+             report.count == expected.size();
+    }
+    std::cout << "Parallel vs flat (multi-shard) -> "
+              << (pass ? "PASS" : "FAIL") << "\n\n";
+    assert(pass);
+  }
+
+  // Skewed input: one value fills almost the whole array, so one shard holds
+  // ~4M elements but only a handful of keys; its table must stay small.
+  {
+    std::mt19937 rng(23);
+    std::vector<int> arr(4000000, 42);
+    for (size_t i = 0; i < arr.size(); i += 1000)
+      arr[i] = static_cast<int>(rng() % 100000);
+    auto expected = findDuplicatesFlat(arr);
+    std::sort(expected.begin(), expected.end());
+    DuplicateReport report = findDuplicatesParallel(arr, 2);
+    std::sort(report.keys.begin(), report.keys.end());
+    bool pass = report.keys == expected && report.peakTableBytes <= (1 << 20);
+    std::cout << "Parallel on skewed input (table "
+              << report.peakTableBytes / 1024 << " KiB) -> "
+              << (pass ? "PASS" : "FAIL") << "\n\n";
+    assert(pass);
+  }
+
+  // Streaming detector: exact when the tier can hold every distinct value.
+  {
+    std::istringstream events("5 10 15 5 3 3 5 42");
+    StreamingDuplicateDetector detector(1 << 12, 4, 64);
+    detector.ingest(events);
+    const auto &stats = detector.statistics();
+    bool pass = stats.observed == 8 && stats.confirmed == 3 &&
+                stats.confirmedKeys == 2 && stats.possible == 0;
+    std::cout << "Streaming exact tier -> " << (pass ? "PASS" : "FAIL")
+              << "\n";
+    assert(pass);
+  }
+
+  // With a tiny exact tier every missed repeat is still flagged as possible
+  // (Bloom filters have no false negatives).
+  {
+    std::mt19937 rng(29);
+    std::uniform_int_distribution<int> dist(0, 20000);
+    std::vector<int> stream(50000);
+    for (auto &v : stream)
+      v = dist(rng);
+    StreamingDuplicateDetector detector(1 << 20, 7, 100);
+    std::unordered_set<int> seen;
+    size_t repeats = 0;
+    bool noFalseNegative = true;
+    for (int v : stream) {
+      bool repeat = !seen.insert(v).second;
+      repeats += repeat;
+      auto outcome = detector.observe(v);
+      noFalseNegative = noFalseNegative &&
+                        (!repeat || outcome !=
+                                        StreamingDuplicateDetector::Outcome::First);
+    }
+    const auto &stats = detector.statistics();
+    bool pass = noFalseNegative && stats.confirmed <= repeats &&
+                stats.confirmed + stats.possible >= repeats;
+    std::cout << "Streaming bounded tier -> " << (pass ? "PASS" : "FAIL")
+              << "\n";
+    assert(pass);
+  }
+
+  // Measured false-positive rate on distinct values tracks the formula.
+  {
+    const size_t distinct = 100000;
+    StreamingDuplicateDetector detector(distinct * 10, 7, 0);
+    for (size_t i = 0; i < distinct; ++i)
+      detector.observe(static_cast<int>(i * 2654435761u));
+    double measured = static_cast<double>(detector.statistics().possible) /
+                      static_cast<double>(distinct);
+    double predicted = StreamingDuplicateDetector::expectedFalsePositiveRate(
+        detector.bloomBits(), 7, distinct);
+    bool pass = measured < 2 * predicted;
+    std::cout << "Streaming FP rate measured=" << measured
+              << " predicted(final)=" << predicted << " -> "
+              << (pass ? "PASS" : "FAIL") << "\n\n";
+    assert(pass);
+  }
+
+  benchmarkDuplicateCounting(1000000);
+  benchmarkParallelDuplicates(1000000, {1, 2, 4, 8, 16, 32, 64});
+  benchmarkStreamingDuplicates(500000);
+
   std::cout << "All tests passed successfully!\n";
   return 0;
 }
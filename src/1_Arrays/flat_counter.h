@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Open-addressing int -> count table with linear probing.
+//
+// Keys and counts live in two parallel arrays (structure of arrays). A count
+// of zero marks an empty slot, so no sentinel key is reserved and every int
+// value can be counted. Unlike std::unordered_map<int, int> there is no node
+// allocation per distinct key and a lookup touches one or two cache lines.
+// The table doubles when it is 70% full; reserve() sizes it up front.
+class FlatIntCounter {
+public:
+  explicit FlatIntCounter(std::size_t expectedKeys = 16) {
+    reserve(expectedKeys);
+  }
+
+  void reserve(std::size_t expectedKeys) {
+    std::size_t wanted = std::bit_ceil(std::max<std::size_t>(
+        16, expectedKeys + expectedKeys / 2 + 1)); // <= ~67% load
+    if (wanted > keys.size())
+      rehash(wanted);
+  }
+
+  // Adds one occurrence of key and returns its new count.
+  std::uint32_t increment(int key) {
+    std::size_t slot = find(key);
+    if (counts[slot] == 0) {
+      if ((used + 1) * 10 > keys.size() * 7) {
+        rehash(keys.size() * 2);
+        slot = find(key);
+      }
+      keys[slot] = key;
+      ++used;
+    }
+    return ++counts[slot];
+  }
+
+  std::uint32_t count(int key) const { return counts[find(key)]; }
+
+  // Number of distinct keys.
+  std::size_t size() const { return used; }
+
+  std::size_t memoryBytes() const {
+    return keys.capacity() * sizeof(int) +
+           counts.capacity() * sizeof(std::uint32_t);
+  }
+
+  void clear() {
+    std::fill(counts.begin(), counts.end(), 0);
+    used = 0;
+  }
+
+  // Calls fn(key, count) for every distinct key, in table order.
+  template <typename Fn> void forEach(Fn fn) const {
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      if (counts[i] != 0)
+        fn(keys[i], counts[i]);
+    }
+  }
+
+private:
+  std::size_t slotFor(int key) const {
+    // Fibonacci hashing: the top bits of a multiplicative hash.
+    std::uint64_t h = static_cast<std::uint32_t>(key) * 0x9E3779B97F4A7C15ull;
+    return static_cast<std::size_t>(h >> shift);
+  }
+
+  // Slot holding key, or the empty slot where it would be inserted.
+  std::size_t find(int key) const {
+    const std::size_t mask = keys.size() - 1;
+    std::size_t slot = slotFor(key);
+    while (counts[slot] != 0 && keys[slot] != key)
+      slot = (slot + 1) & mask;
+    return slot;
+  }
+
+  void rehash(std::size_t capacity) {
+    std::vector<int> oldKeys = std::move(keys);
+    std::vector<std::uint32_t> oldCounts = std::move(counts);
+    keys.assign(capacity, 0);
+    counts.assign(capacity, 0);
+    shift = 64 - std::countr_zero(capacity);
+    for (std::size_t i = 0; i < oldKeys.size(); ++i) {
+      if (oldCounts[i] != 0) {
+        std::size_t slot = find(oldKeys[i]);
+        keys[slot] = oldKeys[i];
+        counts[slot] = oldCounts[i];
+      }
+    }
+  }
+
+  std::vector<int> keys;
+  std::vector<std::uint32_t> counts;
+  std::size_t used = 0;
+  int shift = 64;
+};
+
+// Inclusive [min, max] of a non-empty range.
+inline std::pair<int, int> valueRange(std::span<const int> values) {
+  if (values.empty())
+    throw std::invalid_argument("Array is empty.");
+  auto [lo, hi] = std::minmax_element(values.begin(), values.end());
+  return {*lo, *hi};
+}
+
+// True when a direct-indexed table over [min, max] is cheaper than hashing:
+// the span is at most a few slots per input element and stays below 2^26
+// entries.
+inline bool isDenseRange(int min, int max, std::size_t n) {
+  const std::uint64_t span =
+      static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min) + 1;
+  return span <= (std::uint64_t{1} << 26) && span <= 4 * std::uint64_t{n} + 64;
+}
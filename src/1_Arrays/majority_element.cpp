@@ -26,11 +26,20 @@
  * Output: 1
  */
 
+#include "flat_counter.h"
+
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <random>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -61,20 +70,239 @@ int majorityCounting(const std::vector<int> &arr) {
 }
 
 // Finds and returns the majority element using the frequency dictionary
-// approach (O(n) time, O(n) space).
+// approach (O(n) time, O(n) space). Small value ranges are counted in a plain
+// array indexed by value - min; otherwise a flat open-addressing counter
+// (flat_counter.h) replaces std::unordered_map.
 int majorityFrequency(const std::vector<int> &arr) {
+  if (arr.empty())
+    throw std::invalid_argument("Array is empty.");
+  const size_t n = arr.size();
+  auto [min, max] = valueRange(arr);
+
+  if (isDenseRange(min, max, n)) {
+    std::vector<uint32_t> freq(
+        static_cast<size_t>(static_cast<int64_t>(max) - min) + 1, 0);
+    for (int v : arr) {
+      uint32_t c = ++freq[static_cast<size_t>(static_cast<int64_t>(v) - min)];
+      if (c * size_t{2} > n)
+        return v; // early exit if v is majority
+    }
+  } else {
+    FlatIntCounter freq(std::min<size_t>(n, 1 << 16));
+    for (int v : arr) {
+      uint32_t c = freq.increment(v);
+      if (c * size_t{2} > n)
+        return v; // early exit if v is majority
+    }
+  }
+  throw std::invalid_argument("No majority exists.");
+}
+
+// Node-based hash map version, kept as the benchmark baseline.
+int majorityHashMap(const std::vector<int> &arr) {
   if (arr.empty())
     throw std::invalid_argument("Array is empty.");
   std::unordered_map<int, int> freq;
   const int n = static_cast<int>(arr.size());
   for (int v : arr) {
-    int c = ++freq[v]; // increment the count for v
+    int c = ++freq[v];
     if (c * 2 > n)
-      return v; // early exit if v is majority
+      return v;
   }
   throw std::invalid_argument("No majority exists.");
 }
 
+// Heavy Hitters (Misra-Gries), parallel and streaming.
+//
+// Generalizes Boyer-Moore: a summary with k - 1 counters. A value that
+// already has a counter increments it; a new value takes a free counter;
+// if none is free, every counter is decremented (dropping those that reach
+// zero). Afterwards every value with frequency > n / k is guaranteed to be
+// among the surviving keys, and each counter undercounts by at most n / k.
+// With k = 2 this is exactly the Boyer-Moore vote.
+//
+// Summaries are mergeable (Agarwal et al.): add the counters, then subtract
+// the k-th largest count and drop non-positive ones. The error bound of the
+// merged summary is (n1 + n2) / k, so per-thread or per-chunk summaries can
+// be combined in any order.
+//
+// Candidates may contain false positives; a second pass through
+// HeavyHitterVerifier counts only the k - 1 candidates exactly. Neither
+// phase needs the whole input at once: both accept chunks.
+//
+// Time: O(n k) worst case (linear scan over k - 1 counters, meant for small
+// k), Space: O(k).
+class HeavyHitterSummary {
+public:
+  explicit HeavyHitterSummary(size_t k) : slots(k - 1) {
+    if (k < 2)
+      throw std::invalid_argument("k must be at least 2.");
+    keys.reserve(slots);
+    counts.reserve(slots);
+  }
+
+  void add(int value) {
+    ++total;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (keys[i] == value) {
+        ++counts[i];
+        return;
+      }
+    }
+    if (keys.size() < slots) {
+      keys.push_back(value);
+      counts.push_back(1);
+      return;
+    }
+    // No room: the new value and one occurrence of every key cancel out.
+    size_t kept = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (--counts[i] > 0) {
+        keys[kept] = keys[i];
+        counts[kept] = counts[i];
+        ++kept;
+      }
+    }
+    keys.resize(kept);
+    counts.resize(kept);
+  }
+
+  void add(std::span<const int> chunk) {
+    for (int value : chunk)
+      add(value);
+  }
+
+  void merge(const HeavyHitterSummary &other) {
+    if (other.slots != slots)
+      throw std::invalid_argument("Summaries must share the same k.");
+    total += other.total;
+    for (size_t j = 0; j < other.keys.size(); ++j) {
+      auto it = std::find(keys.begin(), keys.end(), other.keys[j]);
+      if (it != keys.end()) {
+        counts[it - keys.begin()] += other.counts[j];
+      } else {
+        keys.push_back(other.keys[j]);
+        counts.push_back(other.counts[j]);
+      }
+    }
+    if (keys.size() <= slots)
+      return;
+
+    std::vector<uint64_t> sorted = counts;
+    std::nth_element(sorted.begin(), sorted.begin() + slots, sorted.end(),
+                     std::greater<uint64_t>());
+    const uint64_t cut = sorted[slots];
+    size_t kept = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (counts[i] > cut) {
+        keys[kept] = keys[i];
+        counts[kept] = counts[i] - cut;
+        ++kept;
+      }
+    }
+    keys.resize(kept);
+    counts.resize(kept);
+  }
+
+  // Values that may occur more than n / k times (superset of the answer).
+  std::vector<int> candidates() const { return keys; }
+
+  // Lower bound on the frequency of value; the true count is at most
+  // estimate + processed() / k.
+  uint64_t estimate(int value) const {
+    auto it = std::find(keys.begin(), keys.end(), value);
+    return it == keys.end() ? 0 : counts[it - keys.begin()];
+  }
+
+  uint64_t processed() const { return total; }
+  size_t k() const { return slots + 1; }
+
+private:
+  size_t slots;
+  std::vector<int> keys;
+  std::vector<uint64_t> counts;
+  uint64_t total = 0;
+};
+
+// Second pass: exact counts for a fixed candidate list, fed chunk by chunk.
+class HeavyHitterVerifier {
+public:
+  explicit HeavyHitterVerifier(std::vector<int> candidates)
+      : keys(std::move(candidates)), counts(keys.size(), 0) {}
+
+  void add(std::span<const int> chunk) {
+    for (int value : chunk) {
+      auto it = std::find(keys.begin(), keys.end(), value);
+      if (it != keys.end())
+        ++counts[it - keys.begin()];
+    }
+  }
+
+  void merge(const HeavyHitterVerifier &other) {
+    for (size_t i = 0; i < counts.size(); ++i)
+      counts[i] += other.counts[i];
+  }
+
+  // Candidates whose exact frequency exceeds n / k, in ascending order.
+  std::vector<int> result(uint64_t n, size_t k) const {
+    std::vector<int> hitters;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (counts[i] * k > n)
+        hitters.push_back(keys[i]);
+    }
+    std::sort(hitters.begin(), hitters.end());
+    return hitters;
+  }
+
+private:
+  std::vector<int> keys;
+  std::vector<uint64_t> counts;
+};
+
+// All values with frequency > n / k. Both passes split the array into one
+// slice per thread; summaries and verifiers are merged at the end.
+std::vector<int> heavyHitters(const std::vector<int> &arr, size_t k,
+                              unsigned threads = 0) {
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  const size_t chunk = (arr.size() + threads - 1) / threads;
+  auto slice = [&](unsigned t) {
+    const size_t begin = std::min(arr.size(), t * chunk);
+    return std::span<const int>(arr).subspan(
+        begin, std::min(arr.size(), begin + chunk) - begin);
+  };
+  auto runOnThreads = [threads](auto &&body) {
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t)
+      pool.emplace_back(body, t);
+    body(0u);
+    for (auto &thread : pool)
+      thread.join();
+  };
+
+  std::vector<HeavyHitterSummary> summaries(threads, HeavyHitterSummary(k));
+  runOnThreads([&](unsigned t) { summaries[t].add(slice(t)); });
+  for (unsigned t = 1; t < threads; ++t)
+    summaries[0].merge(summaries[t]);
+
+  std::vector<HeavyHitterVerifier> verifiers(
+      threads, HeavyHitterVerifier(summaries[0].candidates()));
+  runOnThreads([&](unsigned t) { verifiers[t].add(slice(t)); });
+  for (unsigned t = 1; t < threads; ++t)
+    verifiers[0].merge(verifiers[t]);
+  return verifiers[0].result(arr.size(), k);
+}
+
+// Majority element through the heavy-hitters engine (k = 2).
+int majorityHeavyHitters(const std::vector<int> &arr) {
+  if (arr.empty())
+    throw std::invalid_argument("Array is empty.");
+  std::vector<int> hitters = heavyHitters(arr, 2);
+  if (hitters.empty())
+    throw std::invalid_argument("No majority exists.");
+  return hitters.front();
+}
+
 // ---- Testing infrastructure ----
 struct TestCase {
   std::string name;
@@ -105,6 +333,128 @@ void runTests(const std::string &title, const std::vector<TestCase> &cases,
   std::cout << "\n";
 }
 
+// Exact frequencies for reference.
+std::vector<int> bruteForceHeavyHitters(const std::vector<int> &arr,
+                                        size_t k) {
+  std::unordered_map<int, size_t> freq;
+  for (int v : arr)
+    ++freq[v];
+  std::vector<int> hitters;
+  for (auto &[value, count] : freq) {
+    if (count * k > arr.size())
+      hitters.push_back(value);
+  }
+  std::sort(hitters.begin(), hitters.end());
+  return hitters;
+}
+
+void testHeavyHitters() {
+  std::cout << "=== Testing heavyHitters (Misra-Gries) ===\n";
+  std::mt19937 rng(8);
+  // Skewed data: a few values are frequent, the rest is noise.
+  std::vector<int> arr;
+  for (int value = 1; value <= 6; ++value)
+    arr.insert(arr.end(), 3000 / value, value * 100);
+  std::uniform_int_distribution<int> noise(1000, 100000);
+  for (int i = 0; i < 20000; ++i)
+    arr.push_back(noise(rng));
+  std::shuffle(arr.begin(), arr.end(), rng);
+
+  for (size_t k : {2, 5, 10, 20}) {
+    for (unsigned threads : {1u, 3u, 8u}) {
+      bool passed = heavyHitters(arr, k, threads) ==
+                    bruteForceHeavyHitters(arr, k);
+      std::cout << "k=" << k << " threads=" << threads << " -> "
+                << (passed ? "PASS" : "FAIL") << "\n";
+      assert(passed);
+    }
+  }
+
+  // Chunked stream: summarize, then verify in a second pass, never holding
+  // more than one chunk.
+  {
+    const size_t k = 10;
+    auto produceChunks = [](auto &&consume) {
+      std::mt19937 gen(99);
+      std::uniform_int_distribution<int> dist(0, 50);
+      std::vector<int> chunk(1000);
+      for (int c = 0; c < 50; ++c) {
+        for (size_t i = 0; i < chunk.size(); ++i)
+          chunk[i] = (i % 4 == 0) ? 7 : dist(gen);
+        consume(std::span<const int>(chunk));
+      }
+    };
+    HeavyHitterSummary summary(k);
+    produceChunks([&](std::span<const int> c) { summary.add(c); });
+    HeavyHitterVerifier verifier(summary.candidates());
+    produceChunks([&](std::span<const int> c) { verifier.add(c); });
+    bool passed = verifier.result(summary.processed(), k) ==
+                  std::vector<int>{7};
+    std::cout << "chunked stream -> " << (passed ? "PASS" : "FAIL") << "\n";
+    assert(passed);
+  }
+
+  // k = 2 merge stays equivalent to Boyer-Moore on majority inputs.
+  {
+    std::vector<int> left = {1, 1, 2, 1};
+    std::vector<int> right = {3, 1, 1, 4, 1};
+    HeavyHitterSummary a(2), b(2);
+    a.add(left);
+    b.add(right);
+    a.merge(b);
+    bool passed = a.candidates() == std::vector<int>{1};
+    std::cout << "k=2 merge keeps majority -> " << (passed ? "PASS" : "FAIL")
+              << "\n\n";
+    assert(passed);
+  }
+}
+
+// ns/element for the frequency approaches. The majority sits at the end of
+// the input so no variant can exit early; the remaining values have the
+// given cardinality, either spread over the whole int range (flat counter
+// path) or packed into [0, cardinality] (dense array path). Pass a larger n
+// (e.g. 10^8) for production-sized inputs.
+void benchmarkMajority(size_t n) {
+  std::mt19937 rng(3);
+  std::cout << "=== Majority frequency, n=" << n << " (ns/element) ===\n";
+  std::cout << std::left << std::setw(14) << "cardinality" << std::setw(12)
+            << "hash map" << std::setw(12) << "flat" << std::setw(12)
+            << "dense" << std::setw(12) << "boyer-moore" << std::setw(12)
+            << "misra-gries" << "\n";
+  for (size_t cardinality : {size_t{16}, size_t{1000}, n / 4}) {
+    std::uniform_int_distribution<int> dist(1, static_cast<int>(cardinality));
+    std::vector<int> dense(n, 0);
+    std::vector<int> sparse(n, 0);
+    for (size_t i = 0; i + 1 < n / 2; ++i) {
+      dense[i] = dist(rng);
+      // Same keys, spread over the full int range: multiplying by an odd
+      // constant is a bijection on uint32_t, so distinct keys stay distinct.
+      sparse[i] = static_cast<int>(static_cast<uint32_t>(dense[i]) *
+                                   uint32_t{2654435761u});
+    }
+    // The "flat" column must time FlatIntCounter, not the dense array.
+    [[maybe_unused]] auto [min, max] = valueRange(sparse);
+    assert(!isDenseRange(min, max, n));
+    auto nsPerElement = [&](int (*fn)(const std::vector<int> &),
+                            const std::vector<int> &arr) {
+      auto t0 = std::chrono::steady_clock::now();
+      volatile int sink = fn(arr);
+      (void)sink;
+      auto t1 = std::chrono::steady_clock::now();
+      return std::chrono::duration<double, std::nano>(t1 - t0).count() /
+             static_cast<double>(n);
+    };
+    std::cout << std::left << std::fixed << std::setprecision(2)
+              << std::setw(14) << cardinality << std::setw(12)
+              << nsPerElement(majorityHashMap, sparse) << std::setw(12)
+              << nsPerElement(majorityFrequency, sparse) << std::setw(12)
+              << nsPerElement(majorityFrequency, dense) << std::setw(12)
+              << nsPerElement(majorityCounting, sparse) << std::setw(12)
+              << nsPerElement(majorityHeavyHitters, sparse) << "\n";
+  }
+  std::cout << "\n";
+}
+
 int main() {
   std::vector<TestCase> cases = {{"No majority", {1, 2, 3, 4, 5}, true, 0},
                                  {"Simple majority", {2, 2, 2, 1, 3}, false, 2},
@@ -126,10 +476,26 @@ int main() {
                                       v[i] = 0;
                                     return v;
                                   }(),
-                                  false, 1}};
+                                  false, 1},
+                                 {"Sparse majority",
+                                  {-2000000000, 2000000000, 2000000000, 5,
+                                   2000000000},
+                                  false, 2000000000},
+                                 {"Sparse no majority",
+                                  {-2000000000, 2000000000, 5, 6},
+                                  true, 0},
+                                 {"Empty", {}, true, 0}};
 
   runTests("Testing majorityCounting (Boyer–Moore)", cases, majorityCounting);
-  runTests("Testing majorityFrequency (Hash Map)", cases, majorityFrequency);
+  runTests("Testing majorityFrequency (Flat Counter)", cases,
+           majorityFrequency);
+  runTests("Testing majorityHashMap (unordered_map)", cases, majorityHashMap);
+  runTests("Testing majorityHeavyHitters (Misra-Gries, k=2)", cases,
+           majorityHeavyHitters);
+
+  testHeavyHitters();
+
+  benchmarkMajority(1000000);
 
   std::cout << "All tests passed successfully!\n";
   return 0;
@@ -11,13 +11,24 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <random>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MERGE_HAS_X86 1
+#else
+#define MERGE_HAS_X86 0
+#endif
+
 // Simple Implementation (O((n+m) log(n+m)))
 void mergeSortedSimple(std::vector<int> &arr1, const std::vector<int> &arr2) {
   arr1.insert(arr1.end(), arr2.begin(), arr2.end());
@@ -51,6 +62,173 @@ void merge_sorted_copy(std::vector<int> &a, const std::vector<int> &b) {
   a = std::move(out);
 }
 
+// Vectorized Merge Kernel (bitonic merge network, AVX2)
+// Merges 8 + 8 sorted ints per step in registers: reversing one input makes
+// the 16 values bitonic, one min/max splits them into a low and a high half,
+// and three more min/max + shuffle stages sort each half. The low half is
+// stored; the high half is merged with the next 8-wide block taken from
+// whichever input has the smaller head. Inputs shorter than one block and
+// the final tail are merged with scalar code. Selected at runtime when the
+// CPU supports AVX2, otherwise std::merge is used.
+#if MERGE_HAS_X86
+namespace simd_merge {
+__attribute__((target("avx2"))) inline __m256i sortBitonic8(__m256i v) {
+  __m256i x = _mm256_permute2x128_si256(v, v, 0x01); // distance 4
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, x), _mm256_max_epi32(v, x), 0xF0);
+  x = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)); // distance 2
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, x), _mm256_max_epi32(v, x), 0xCC);
+  x = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)); // distance 1
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, x), _mm256_max_epi32(v, x), 0xAA);
+  return v;
+}
+
+// a and b are sorted; on return lo holds the 8 smallest values, hi the rest.
+__attribute__((target("avx2"))) inline void merge8x8(__m256i a, __m256i b,
+                                                      __m256i &lo,
+                                                      __m256i &hi) {
+  const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  b = _mm256_permutevar8x32_epi32(b, reverse);
+  lo = sortBitonic8(_mm256_min_epi32(a, b));
+  hi = sortBitonic8(_mm256_max_epi32(a, b));
+}
+
+__attribute__((target("avx2"))) inline __m256i load(const int *p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+__attribute__((target("avx2"))) inline void
+mergeAvx2(const int *a, size_t n, const int *b, size_t m, int *out) {
+  if (n < 8 || m < 8) {
+    std::merge(a, a + n, b, b + m, out);
+    return;
+  }
+
+  __m256i lo, hi;
+  merge8x8(load(a), load(b), lo, hi);
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), lo);
+  out += 8;
+  size_t ia = 8, ib = 8;
+  while (true) {
+    const int *next;
+    if (ia < n && (ib == m || a[ia] <= b[ib])) {
+      if (n - ia < 8)
+        break;
+      next = a + ia;
+      ia += 8;
+    } else {
+      if (ib == m || m - ib < 8)
+        break;
+      next = b + ib;
+      ib += 8;
+    }
+    merge8x8(hi, load(next), lo, hi);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), lo);
+    out += 8;
+  }
+
+  // Scalar three-way merge of the pending register and both tails.
+  alignas(32) int pending[8];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(pending), hi);
+  size_t ip = 0;
+  while (ip < 8 || ia < n || ib < m) {
+    int best = std::numeric_limits<int>::max();
+    int source = -1;
+    if (ip < 8) {
+      best = pending[ip];
+      source = 0;
+    }
+    if (ia < n && (source < 0 || a[ia] < best)) {
+      best = a[ia];
+      source = 1;
+    }
+    if (ib < m && (source < 0 || b[ib] < best)) {
+      best = b[ib];
+      source = 2;
+    }
+    *out++ = best;
+    if (source == 0)
+      ++ip;
+    else if (source == 1)
+      ++ia;
+    else
+      ++ib;
+  }
+}
+
+inline bool cpuHasAvx2() {
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+}
+} // namespace simd_merge
+#endif
+
+// Merges a[0..n) and b[0..m) into out, choosing the fastest kernel.
+void mergeKernel(const int *a, size_t n, const int *b, size_t m, int *out) {
+#if MERGE_HAS_X86
+  if (simd_merge::cpuHasAvx2()) {
+    simd_merge::mergeAvx2(a, n, b, m, out);
+    return;
+  }
+#endif
+  std::merge(a, a + n, b, b + m, out);
+}
+
+// Copy-merge through the vectorized kernel, replaces contents of 'a'
+void mergeSortedSimd(std::vector<int> &a, const std::vector<int> &b) {
+  std::vector<int> out(a.size() + b.size());
+  mergeKernel(a.data(), a.size(), b.data(), b.size(), out.data());
+  a = std::move(out);
+}
+
+// Merge Path Partition
+// Returns how many of the first `diagonal` merged outputs come from a; the
+// remaining diagonal - i come from b. Binary search along the diagonal of
+// the merge matrix, O(log min(n, m)).
+size_t mergePathSplit(const int *a, size_t n, const int *b, size_t m,
+                      size_t diagonal) {
+  size_t lo = diagonal > m ? diagonal - m : 0;
+  size_t hi = std::min(diagonal, n);
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (a[mid] <= b[diagonal - mid - 1])
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+// Parallel Merge (merge path)
+// The output is cut into T equal slices. For each slice boundary a binary
+// search on the merge-path diagonal finds where the inputs split, so every
+// thread merges exactly (n + m) / T outputs with no further coordination.
+// Time: O((n + m) / T + T log n), Space: O(n + m). Replaces contents of 'a'.
+void mergeSortedParallel(std::vector<int> &a, const std::vector<int> &b,
+                         unsigned threads = 0) {
+  const size_t n = a.size(), m = b.size(), total = n + m;
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = static_cast<unsigned>(
+      std::min<size_t>(threads, std::max<size_t>(1, total / 4096)));
+
+  std::vector<int> out(total);
+  auto work = [&](unsigned t) {
+    const size_t begin = total * t / threads;
+    const size_t end = total * (t + 1) / threads;
+    const size_t ia = mergePathSplit(a.data(), n, b.data(), m, begin);
+    const size_t ja = mergePathSplit(a.data(), n, b.data(), m, end);
+    mergeKernel(a.data() + ia, ja - ia, b.data() + (begin - ia),
+                (end - ja) - (begin - ia), out.data() + begin);
+  };
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; ++t)
+    pool.emplace_back(work, t);
+  work(0);
+  for (auto &thread : pool)
+    thread.join();
+  a = std::move(out);
+}
+
 // --- Test case struct ---
 struct TestCaseMerge {
   std::string name;
@@ -116,11 +294,30 @@ void testMergeCopy(const std::vector<TestCaseMerge> &cases) {
   std::cout << "\n";
 }
 
+template <typename Merge>
+void testMergeWith(const std::string &title, Merge merge,
+                   const std::vector<TestCaseMerge> &cases) {
+  std::cout << "=== Testing " << title << " ===\n";
+  for (const auto &tc : cases) {
+    auto got = tc.a;
+    merge(got, tc.b);
+    bool pass = (got == tc.expected);
+    std::cout << tc.name << ": expected=";
+    printVec(tc.expected);
+    std::cout << ", got=";
+    printVec(got);
+    std::cout << " -> " << (pass ? "PASS" : "FAIL") << "\n";
+    assert(pass);
+  }
+  std::cout << "\n";
+}
+
 // Property-style randomized test to ensure all implementations agree
-void testEquivalenceRandom(int trials = 200) {
-  std::cout << "=== Randomized equivalence (all three agree) ===\n";
-  std::mt19937 rng(1234567);
-  std::uniform_int_distribution<int> lenDist(0, 20);
+void testEquivalenceRandom(int trials = 200, int maxLen = 20) {
+  std::cout << "=== Randomized equivalence (all variants agree, maxLen="
+            << maxLen << ") ===\n";
+  std::mt19937 rng(1234567 + maxLen);
+  std::uniform_int_distribution<int> lenDist(0, maxLen);
   std::uniform_int_distribution<int> valDist(-10, 10);
 
   for (int t = 0; t < trials; ++t) {
@@ -136,12 +333,14 @@ void testEquivalenceRandom(int trials = 200) {
     std::sort(a.begin(), a.end());
     std::sort(b.begin(), b.end());
 
-    auto a1 = a, a2 = a, a3 = a;
+    auto a1 = a, a2 = a, a3 = a, a4 = a, a5 = a;
     mergeSortedSimple(a1, b);
     mergeSortedOptimal(a2, b);
     merge_sorted_copy(a3, b);
+    mergeSortedSimd(a4, b);
+    mergeSortedParallel(a5, b, 1 + t % 5);
 
-    bool agree = (a1 == a2) && (a2 == a3);
+    bool agree = (a1 == a2) && (a2 == a3) && (a3 == a4) && (a4 == a5);
     if (!agree) {
       std::cout << "Disagreement on trial " << t << "\n";
       std::cout << "a=";
@@ -158,12 +357,57 @@ void testEquivalenceRandom(int trials = 200) {
       std::cout << "copy  =";
       printVec(a3);
       std::cout << "\n";
+      std::cout << "simd  =";
+      printVec(a4);
+      std::cout << "\n";
+      std::cout << "parallel=";
+      printVec(a5);
+      std::cout << "\n";
     }
     assert(agree);
   }
   std::cout << "Randomized checks passed.\n\n";
 }
 
+// Throughput of the merge variants on two sorted halves of n random ints.
+// Pass sizes up to 10^9 for production-scale numbers.
+void benchmarkMerge(const std::vector<size_t> &sizes) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist;
+  std::cout << "=== Merge throughput (Melem/s) ===\n";
+  std::cout << std::left << std::setw(12) << "n" << std::setw(12)
+            << "optimal" << std::setw(12) << "std::merge" << std::setw(12)
+            << "simd" << std::setw(12) << "parallel" << "\n";
+  for (size_t n : sizes) {
+    std::vector<int> a(n / 2), b(n - n / 2);
+    for (int &x : a)
+      x = dist(rng);
+    for (int &x : b)
+      x = dist(rng);
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+
+    auto rate = [&](auto &&merge) {
+      std::vector<int> work = a;
+      auto t0 = std::chrono::steady_clock::now();
+      merge(work, b);
+      auto t1 = std::chrono::steady_clock::now();
+      return static_cast<double>(n) /
+             std::chrono::duration<double>(t1 - t0).count() / 1e6;
+    };
+    std::cout << std::left << std::fixed << std::setprecision(1)
+              << std::setw(12) << n << std::setw(12)
+              << rate(mergeSortedOptimal) << std::setw(12)
+              << rate(merge_sorted_copy) << std::setw(12)
+              << rate(mergeSortedSimd) << std::setw(12)
+              << rate([](std::vector<int> &x, const std::vector<int> &y) {
+                   mergeSortedParallel(x, y);
+                 })
+              << "\n";
+  }
+  std::cout << "\n";
+}
+
 int main() {
   std::vector<TestCaseMerge> cases = {
       {"Interleaved", {1, 3, 5}, {2, 4, 6}, {1, 2, 3, 4, 5, 6}},
@@ -179,7 +423,17 @@ int main() {
   testMergeSimple(cases);
   testMergeOptimal(cases);
   testMergeCopy(cases);
+  testMergeWith("mergeSortedSimd", mergeSortedSimd, cases);
+  testMergeWith(
+      "mergeSortedParallel",
+      [](std::vector<int> &a, const std::vector<int> &b) {
+        mergeSortedParallel(a, b, 3);
+      },
+      cases);
   testEquivalenceRandom();
+  testEquivalenceRandom(30, 20000);
+
+  benchmarkMerge({100000, 1000000, 4000000});
 
   std::cout << "All tests passed successfully!\n";
   return 0;
@@ -8,9 +8,14 @@
  * Output: 1
  */
 
+#include "simd_min.h"
+
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -28,6 +33,17 @@ int findMinOptimal(const std::vector<int> &arr) {
   return *std::min_element(arr.begin(), arr.end());
 }
 
+// Vectorized Solution (O(n), SIMD)
+// AVX2/SSE4.1 kernels from simd_min.h, picked at runtime.
+int findMinSimd(const std::vector<int> &arr) {
+  return minOf(arr.data(), arr.size());
+}
+
+// Position of the first minimum, same kernels.
+size_t findArgminSimd(const std::vector<int> &arr) {
+  return argminOf(arr.data(), arr.size());
+}
+
 struct TestCase {
   std::string name;
   std::vector<int> arr;
@@ -58,6 +74,81 @@ void testFindMinOptimal(const std::vector<TestCase> &cases) {
   std::cout << "\n";
 }
 
+void testFindMinSimd(const std::vector<TestCase> &cases) {
+  std::cout << "=== Testing findMinSimd / findArgminSimd ===\n";
+  for (const auto &tc : cases) {
+    int got = findMinSimd(tc.arr);
+    size_t index = findArgminSimd(tc.arr);
+    size_t expectedIndex =
+        std::min_element(tc.arr.begin(), tc.arr.end()) - tc.arr.begin();
+    bool pass = (got == tc.expected) && (index == expectedIndex);
+    std::cout << tc.name << ": expected=" << tc.expected << "@"
+              << expectedIndex << ", got=" << got << "@" << index << " -> "
+              << (pass ? "PASS" : "FAIL") << "\n";
+    assert(pass);
+  }
+  std::cout << "\n";
+}
+
+// Every dispatch level agrees with std::min_element on random arrays of
+// awkward lengths (tails, several argmin blocks, repeated minima).
+void testSimdLevelsRandom() {
+  std::cout << "=== Randomized SIMD levels ===\n";
+  std::mt19937 rng(77);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  for (size_t n : {1, 7, 8, 31, 33, 100, 2047, 2048, 2049, 10000}) {
+    std::vector<int> arr(n);
+    for (int &x : arr)
+      x = dist(rng);
+    auto it = std::min_element(arr.begin(), arr.end());
+    for (SimdLevel level : kMinSimdLevels) {
+      bool pass = minOf(arr.data(), n, level) == *it &&
+                  argminOf(arr.data(), n, level) ==
+                      static_cast<size_t>(it - arr.begin());
+      assert(pass);
+    }
+  }
+  std::cout << "Randomized checks passed.\n\n";
+}
+
+// GB/s of the scalar loop, std::min_element and each SIMD level.
+void benchmarkFindMin(size_t n) {
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<int> dist;
+  std::vector<int> arr(n);
+  for (int &x : arr)
+    x = dist(rng);
+  const double bytes = static_cast<double>(n * sizeof(int));
+
+  auto gbPerSecond = [&](auto &&fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    volatile size_t sink = static_cast<size_t>(fn());
+    (void)sink;
+    auto t1 = std::chrono::steady_clock::now();
+    return bytes / std::chrono::duration<double>(t1 - t0).count() / 1e9;
+  };
+
+  std::cout << "=== Min over " << n << " ints (GB/s) ===\n" << std::fixed
+            << std::setprecision(2);
+  std::cout << "  findMinSimple   " << gbPerSecond([&] {
+    return findMinSimple(arr);
+  }) << "\n";
+  std::cout << "  findMinOptimal  " << gbPerSecond([&] {
+    return findMinOptimal(arr);
+  }) << "\n";
+  for (SimdLevel level : kMinSimdLevels) {
+    std::cout << "  min    " << std::left << std::setw(8)
+              << simdLevelName(level) << std::right
+              << gbPerSecond([&] { return minOf(arr.data(), n, level); })
+              << "\n";
+    std::cout << "  argmin " << std::left << std::setw(8)
+              << simdLevelName(level) << std::right
+              << gbPerSecond([&] { return argminOf(arr.data(), n, level); })
+              << "\n";
+  }
+  std::cout << "\n";
+}
+
 int main() {
   std::vector<TestCase> cases = {{"Random order", {3, 5, 1, 4, 2}, 1},
                                  {"All negatives", {-3, -5, -1, -4}, -5},
@@ -68,6 +159,9 @@ int main() {
 
   testFindMinSimple(cases);
   testFindMinOptimal(cases);
+  testFindMinSimd(cases);
+  testSimdLevelsRandom();
+  benchmarkFindMin(1 << 24);
 
   std::cout << "All tests passed successfully!\n";
   return 0;
@@ -15,11 +15,28 @@
  * Explanation: All odd numbers (1,3,5,7) appear before even numbers (2,4,6).
  */
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <random>
+#include <span>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define REORDER_HAS_X86 1
+#else
+#define REORDER_HAS_X86 0
+#endif
+
 // Helper function to determine if a number is even
 bool isEven(int num) { return (num & 1) == 0; }
 
@@ -42,6 +59,230 @@ std::vector<int> optimalSolution(std::vector<int> arr) {
   return arr;
 }
 
+// Predicate type of the odd/even specialization below.
+struct IsOdd {
+  bool operator()(int num) const { return !isEven(num); }
+};
+
+// Stable Out-of-place Odd/Even Partition (O(n))
+// Odds keep their order at the front of out, evens keep theirs after them.
+// The AVX2 kernel emulates a compress-store: the odd-lane bitmask of 8 values
+// selects a precomputed permutation that packs the chosen lanes to the
+// front, then all 8 lanes are stored and the cursor advances by the popcount.
+namespace stable_partition_detail {
+inline void partitionOddEvenScalar(const int *in, size_t n, int *odds,
+                                   int *evens) {
+  for (size_t i = 0; i < n; ++i) {
+    if (in[i] & 1)
+      *odds++ = in[i];
+    else
+      *evens++ = in[i];
+  }
+}
+
+#if REORDER_HAS_X86
+struct CompressTable {
+  std::array<std::array<int, 8>, 256> lanes{};
+  constexpr CompressTable() {
+    for (int mask = 0; mask < 256; ++mask) {
+      int k = 0;
+      for (int lane = 0; lane < 8; ++lane) {
+        if (mask & (1 << lane))
+          lanes[mask][k++] = lane;
+      }
+    }
+  }
+};
+inline constexpr CompressTable compressTable{};
+
+__attribute__((target("avx2"))) inline void
+storeCompressed(__m256i v, unsigned mask, int *&dst, const int *limit) {
+  const __m256i perm = _mm256_loadu_si256(
+      reinterpret_cast<const __m256i *>(compressTable.lanes[mask].data()));
+  const __m256i packed = _mm256_permutevar8x32_epi32(v, perm);
+  const int count = __builtin_popcount(mask);
+  if (dst + 8 <= limit) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), packed);
+  } else {
+    // Near the end of a region a full store would clobber the other one.
+    alignas(32) int tmp[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(tmp), packed);
+    std::copy(tmp, tmp + count, dst);
+  }
+  dst += count;
+}
+
+__attribute__((target("avx2"))) inline void
+partitionOddEvenAvx2(const int *in, size_t n, int *odds, int *evens) {
+  int *const oddLimit = evens; // the odd region ends where evens begin
+  int *const evenLimit = evens + (n - (evens - odds));
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    const unsigned oddMask = static_cast<unsigned>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_slli_epi32(v, 31))));
+    storeCompressed(v, oddMask, odds, oddLimit);
+    storeCompressed(v, ~oddMask & 0xFFu, evens, evenLimit);
+  }
+  partitionOddEvenScalar(in + i, n - i, odds, evens);
+}
+
+inline bool cpuHasAvx2() {
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+}
+#endif
+} // namespace stable_partition_detail
+
+// Returns the number of odd values; out.size() must equal in.size().
+size_t stablePartitionOddEvenCopy(std::span<const int> in, std::span<int> out,
+                                  bool allowSimd = true) {
+  assert(out.size() == in.size());
+  size_t oddCount = 0;
+  for (int num : in)
+    oddCount += num & 1;
+  int *odds = out.data(), *evens = out.data() + oddCount;
+#if REORDER_HAS_X86
+  if (allowSimd && stable_partition_detail::cpuHasAvx2()) {
+    stable_partition_detail::partitionOddEvenAvx2(in.data(), in.size(), odds,
+                                                  evens);
+    return oddCount;
+  }
+#endif
+  stable_partition_detail::partitionOddEvenScalar(in.data(), in.size(), odds,
+                                                  evens);
+  return oddCount;
+}
+
+// Stable In-place Partition (O(n log n) moves, O(1) extra memory)
+// Divide and conquer: partition both halves, then one rotation swaps the
+// left half's "false" block with the right half's "true" block. Leaves of
+// up to kLeaf elements are partitioned through a scratch vector reused
+// across leaves (any movable T); for contiguous ints with IsOdd they go
+// through the vectorized kernel above instead.
+//
+// With threads > 1 every thread partitions one contiguous chunk, then
+// neighbouring chunks are merged pairwise, level by level, with the same
+// rotation. Rotations are done as three reversals whose element swaps are
+// split across all threads.
+namespace stable_partition_detail {
+constexpr size_t kLeaf = 1024;
+
+template <typename It>
+using ScratchFor = std::vector<typename std::iterator_traits<It>::value_type>;
+
+template <typename It, typename Pred>
+It partitionLeaf(It first, It last, Pred &pred, ScratchFor<It> &scratch) {
+  using T = typename std::iterator_traits<It>::value_type;
+  if constexpr (std::is_same_v<T, int> && std::is_same_v<Pred, IsOdd> &&
+                std::contiguous_iterator<It>) {
+    std::array<int, kLeaf> buffer;
+    const size_t n = static_cast<size_t>(last - first);
+    std::copy(first, last, buffer.begin());
+    size_t odds = stablePartitionOddEvenCopy(
+        std::span<const int>(buffer.data(), n),
+        std::span<int>(std::to_address(first), n));
+    return first + odds;
+  } else {
+    scratch.clear();
+    It out = first;
+    for (It it = first; it != last; ++it) {
+      if (!pred(*it)) {
+        scratch.push_back(std::move(*it));
+        continue;
+      }
+      if (out != it) // self-move-assignment may empty the element
+        *out = std::move(*it);
+      ++out;
+    }
+    std::move(scratch.begin(), scratch.end(), out);
+    return out;
+  }
+}
+
+template <typename It, typename Pred>
+It partitionSerial(It first, It last, Pred &pred, ScratchFor<It> &scratch) {
+  if (last - first <= static_cast<std::ptrdiff_t>(kLeaf))
+    return partitionLeaf(first, last, pred, scratch);
+  It mid = first + (last - first) / 2;
+  It left = partitionSerial(first, mid, pred, scratch);
+  It right = partitionSerial(mid, last, pred, scratch);
+  return std::rotate(left, mid, right);
+}
+
+// Runs body(t) for t in [0, threads) on separate threads.
+template <typename Body> void runOnThreads(unsigned threads, Body &&body) {
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; ++t)
+    pool.emplace_back(body, t);
+  body(0);
+  for (auto &thread : pool)
+    thread.join();
+}
+
+template <typename It> void parallelReverse(It first, It last, unsigned threads) {
+  const size_t swaps = static_cast<size_t>(last - first) / 2;
+  if (threads <= 1 || swaps < 65536) {
+    std::reverse(first, last);
+    return;
+  }
+  const size_t chunk = (swaps + threads - 1) / threads;
+  runOnThreads(threads, [&](unsigned t) {
+    const size_t begin = std::min(swaps, t * chunk);
+    const size_t end = std::min(swaps, begin + chunk);
+    for (size_t i = begin; i < end; ++i)
+      std::iter_swap(first + i, last - 1 - i);
+  });
+}
+
+// Same result as std::rotate(first, middle, last).
+template <typename It>
+It parallelRotate(It first, It middle, It last, unsigned threads) {
+  parallelReverse(first, middle, threads);
+  parallelReverse(middle, last, threads);
+  parallelReverse(first, last, threads);
+  return first + (last - middle);
+}
+} // namespace stable_partition_detail
+
+template <typename It, typename Pred>
+It stablePartitionInPlace(It first, It last, Pred pred, unsigned threads = 1) {
+  using namespace stable_partition_detail;
+  const size_t n = static_cast<size_t>(last - first);
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = static_cast<unsigned>(std::min<size_t>(threads, n / kLeaf + 1));
+  if (threads <= 1) {
+    ScratchFor<It> scratch;
+    return partitionSerial(first, last, pred, scratch);
+  }
+
+  // Chunk t covers [bounds[t], bounds[t + 1]); split[t] is its partition point.
+  std::vector<It> bounds(threads + 1), split(threads);
+  for (unsigned t = 0; t <= threads; ++t)
+    bounds[t] = first + static_cast<std::ptrdiff_t>(n * t / threads);
+  runOnThreads(threads, [&](unsigned t) {
+    Pred local = pred;
+    ScratchFor<It> scratch;
+    split[t] = partitionSerial(bounds[t], bounds[t + 1], local, scratch);
+  });
+
+  for (unsigned width = 1; width < threads; width *= 2) {
+    for (unsigned t = 0; t + width < threads; t += 2 * width) {
+      // [trues | falses][trues | falses] -> [trues trues | falses falses]
+      split[t] = parallelRotate(split[t], bounds[t + width], split[t + width],
+                                threads);
+    }
+  }
+  return split[0];
+}
+
+// Stable In-place Odd/Even Solution
+std::vector<int> stableSolution(std::vector<int> arr, unsigned threads = 1) {
+  stablePartitionInPlace(arr.begin(), arr.end(), IsOdd{}, threads);
+  return arr;
+}
+
 struct TestCase {
   std::string name;
   std::vector<int> input;
@@ -79,6 +320,146 @@ void testOptimalSolution(const std::vector<TestCase> &cases) {
   std::cout << "\n";
 }
 
+void testStableSolution(const std::vector<TestCase> &cases) {
+  std::cout << "=== Testing stableSolution ===\n";
+  for (const auto &tc : cases) {
+    auto expected = simpleSolution(tc.input); // simpleSolution is stable
+    std::vector<int> copied(tc.input.size());
+    stablePartitionOddEvenCopy(tc.input, copied);
+    bool pass = stableSolution(tc.input) == expected &&
+                stableSolution(tc.input, 4) == expected && copied == expected;
+    std::cout << tc.name << " -> " << (pass ? "PASS" : "FAIL") << "\n";
+    assert(pass);
+  }
+  std::cout << "\n";
+}
+
+// Random inputs of awkward sizes (around the leaf size, vector width and
+// chunk boundaries) must match std::stable_partition exactly; pairs with a
+// predicate on .first also check stability of a generic element type.
+void testStableRandom() {
+  std::cout << "=== Randomized stable partition ===\n";
+  std::mt19937 rng(40);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  for (size_t n : {1, 7, 8, 9, 1023, 1024, 1025, 5000, 100000}) {
+    std::vector<int> input(n);
+    for (int &x : input)
+      x = dist(rng);
+    std::vector<int> expected = input;
+    const size_t oddCount = static_cast<size_t>(
+        std::stable_partition(expected.begin(), expected.end(), IsOdd{}) -
+        expected.begin());
+
+    for (bool allowSimd : {false, true}) {
+      std::vector<int> copied(n);
+      size_t odds = stablePartitionOddEvenCopy(input, copied, allowSimd);
+      assert(copied == expected && odds == oddCount);
+    }
+    for (unsigned threads : {1u, 2u, 3u, 8u}) {
+      std::vector<int> arr = input;
+      auto mid = stablePartitionInPlace(arr.begin(), arr.end(), IsOdd{}, threads);
+      assert(arr == expected && mid == arr.begin() + oddCount);
+    }
+
+    std::vector<std::pair<int, size_t>> tagged(n);
+    for (size_t i = 0; i < n; ++i)
+      tagged[i] = {dist(rng), i};
+    auto byThree = [](const std::pair<int, size_t> &p) {
+      return p.first % 3 == 0;
+    };
+    auto taggedExpected = tagged;
+    std::stable_partition(taggedExpected.begin(), taggedExpected.end(), byThree);
+    for (unsigned threads : {1u, 5u}) {
+      auto arr = tagged;
+      stablePartitionInPlace(arr.begin(), arr.end(), byThree, threads);
+      assert(arr == taggedExpected);
+    }
+  }
+  std::cout << "Randomized checks passed.\n\n";
+}
+
+// Non-trivial element types: moves must neither lose data (self-move of a
+// string or vector empties it) nor require default construction.
+void testStableNonTrivial() {
+  std::cout << "=== Stable partition of strings and vectors ===\n";
+  std::vector<std::vector<int>> lists = {{1}, {2, 2}, {3}, {4, 4}, {5}};
+  auto single = [](const std::vector<int> &v) { return v.size() == 1; };
+  stablePartitionInPlace(lists.begin(), lists.end(), single);
+  const std::vector<std::vector<int>> expectedLists = {
+      {1}, {3}, {5}, {2, 2}, {4, 4}};
+  assert(lists == expectedLists);
+
+  struct NoDefault {
+    explicit NoDefault(std::string s) : text(std::move(s)) {}
+    std::string text;
+    bool operator==(const NoDefault &) const = default;
+  };
+  std::mt19937 rng(41);
+  for (size_t n : {5, 1024, 3000}) {
+    std::vector<std::string> words;
+    std::vector<NoDefault> wrapped;
+    for (size_t i = 0; i < n; ++i) {
+      words.push_back(std::string(1 + rng() % 30, 'a' + rng() % 26) +
+                      std::to_string(i)); // long enough to live on the heap
+      wrapped.emplace_back(words.back());
+    }
+    auto shortWord = [](const std::string &w) { return w.size() < 16; };
+    auto expected = words;
+    std::stable_partition(expected.begin(), expected.end(), shortWord);
+    for (unsigned threads : {1u, 3u}) {
+      auto arr = words;
+      stablePartitionInPlace(arr.begin(), arr.end(), shortWord, threads);
+      assert(arr == expected);
+    }
+    auto wrappedShort = [&](const NoDefault &w) { return shortWord(w.text); };
+    auto wrappedExpected = wrapped;
+    std::stable_partition(wrappedExpected.begin(), wrappedExpected.end(),
+                          wrappedShort);
+    stablePartitionInPlace(wrapped.begin(), wrapped.end(), wrappedShort, 2);
+    assert(wrapped == wrappedExpected);
+  }
+  std::cout << "Non-trivial element checks passed.\n\n";
+}
+
+// Milliseconds to partition n random ints by parity.
+void benchmarkStablePartition(size_t n) {
+  std::mt19937 rng(7);
+  std::vector<int> input(n);
+  for (int &x : input)
+    x = static_cast<int>(rng());
+  std::vector<int> work, out(n);
+
+  auto ms = [&](auto &&fn) {
+    work = input;
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+  };
+  const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+
+  std::cout << "=== Odd/even partition, n=" << n << " (ms) ===\n" << std::fixed
+            << std::setprecision(1);
+  std::cout << "  std::partition (unstable)  " << ms([&] {
+    std::partition(work.begin(), work.end(), IsOdd{});
+  }) << "\n";
+  std::cout << "  std::stable_partition      " << ms([&] {
+    std::stable_partition(work.begin(), work.end(), IsOdd{});
+  }) << "\n";
+  std::cout << "  in-place, 1 thread         " << ms([&] {
+    stablePartitionInPlace(work.begin(), work.end(), IsOdd{}, 1);
+  }) << "\n";
+  std::cout << "  in-place, " << std::setw(2) << hw << " threads        "
+            << ms([&] {
+                 stablePartitionInPlace(work.begin(), work.end(), IsOdd{}, hw);
+               })
+            << "\n";
+  std::cout << "  copy, scalar               "
+            << ms([&] { stablePartitionOddEvenCopy(work, out, false); }) << "\n";
+  std::cout << "  copy, AVX2 compress        "
+            << ms([&] { stablePartitionOddEvenCopy(work, out, true); }) << "\n\n";
+}
+
 int main() {
   std::vector<TestCase> cases = {
       {"Mixed odds and evens", {1, 2, 3, 4, 5, 6, 7}},
@@ -93,6 +474,10 @@ int main() {
 
   testSimpleSolution(cases);
   testOptimalSolution(cases);
+  testStableSolution(cases);
+  testStableRandom();
+  testStableNonTrivial();
+  benchmarkStablePartition(1 << 22);
 
   std::cout << "All tests passed successfully!\n";
   return 0;
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "../2_Strings/simd_dispatch.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+// Minimum and argmin over int arrays with runtime CPU dispatch.
+//
+// minOf() keeps several independent vector accumulators so consecutive
+// loads do not wait on each other, then reduces them horizontally.
+// argminOf() avoids tracking indices in registers: it computes the minimum
+// of fixed-size blocks with the same kernel, remembers the first block whose
+// minimum is strictly smaller than everything before it, and finally scans
+// only that block for the first matching position. The array is read about
+// once.
+//
+// The best of AVX2, SSE4.1 and portable scalar code is picked on first use;
+// every level can also be requested explicitly (for tests and benchmarks).
+// Levels come from simd_dispatch.h; SSSE3 requests run the scalar code.
+inline constexpr std::array<SimdLevel, 3> kMinSimdLevels = {
+    SimdLevel::Scalar, SimdLevel::Sse41, SimdLevel::Avx2};
+
+namespace simd_min_detail {
+inline int minScalar(const int *data, std::size_t n) {
+  int best = data[0];
+  for (std::size_t i = 1; i < n; ++i)
+    best = data[i] < best ? data[i] : best;
+  return best;
+}
+
+#if SIMD_DISPATCH_HAS_X86
+__attribute__((target("sse4.1"))) inline int minSse41(const int *data,
+                                                      std::size_t n) {
+  if (n < 8)
+    return minScalar(data, n);
+  __m128i acc0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+  __m128i acc1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 4));
+  std::size_t i = 8;
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm_min_epi32(
+        acc0, _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)));
+    acc1 = _mm_min_epi32(
+        acc1, _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 4)));
+  }
+  __m128i v = _mm_min_epi32(acc0, acc1);
+  v = _mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = _mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  int best = _mm_cvtsi128_si32(v);
+  for (; i < n; ++i)
+    best = data[i] < best ? data[i] : best;
+  return best;
+}
+
+__attribute__((target("avx2"))) inline __m256i load8(const int *p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+__attribute__((target("avx2"))) inline int minAvx2(const int *data,
+                                                   std::size_t n) {
+  if (n < 32)
+    return minScalar(data, n);
+  __m256i acc0 = load8(data);
+  __m256i acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    acc0 = _mm256_min_epi32(acc0, load8(data + i));
+    acc1 = _mm256_min_epi32(acc1, load8(data + i + 8));
+    acc2 = _mm256_min_epi32(acc2, load8(data + i + 16));
+    acc3 = _mm256_min_epi32(acc3, load8(data + i + 24));
+  }
+  __m256i v = _mm256_min_epi32(_mm256_min_epi32(acc0, acc1),
+                               _mm256_min_epi32(acc2, acc3));
+  __m128i h = _mm_min_epi32(_mm256_castsi256_si128(v),
+                            _mm256_extracti128_si256(v, 1));
+  h = _mm_min_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(1, 0, 3, 2)));
+  h = _mm_min_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(2, 3, 0, 1)));
+  int best = _mm_cvtsi128_si32(h);
+  for (; i < n; ++i)
+    best = data[i] < best ? data[i] : best;
+  return best;
+}
+#endif
+} // namespace simd_min_detail
+
+// Levels the running CPU cannot execute fall back to the best supported one.
+inline int minOf(const int *data, std::size_t n,
+                 SimdLevel level = detectSimdLevel()) {
+  if (n == 0)
+    throw std::invalid_argument("Array is empty.");
+  level = supportedSimdLevel(level, kMinSimdLevels);
+#if SIMD_DISPATCH_HAS_X86
+  if (level == SimdLevel::Avx2)
+    return simd_min_detail::minAvx2(data, n);
+  if (level == SimdLevel::Sse41)
+    return simd_min_detail::minSse41(data, n);
+#endif
+  return simd_min_detail::minScalar(data, n);
+}
+
+// Index of the first occurrence of the minimum.
+inline std::size_t argminOf(const int *data, std::size_t n,
+                            SimdLevel level = detectSimdLevel()) {
+  if (n == 0)
+    throw std::invalid_argument("Array is empty.");
+  constexpr std::size_t block = 2048; // 8 KiB, stays in L1 for the rescan
+  std::size_t bestBlock = 0;
+  int best = minOf(data, std::min(n, block), level);
+  for (std::size_t start = block; start < n; start += block) {
+    int candidate = minOf(data + start, std::min(block, n - start), level);
+    if (candidate < best) {
+      best = candidate;
+      bestBlock = start;
+    }
+  }
+  return static_cast<std::size_t>(std::find(data + bestBlock, data + n, best) -
+                                  data);
+}
@@ -15,9 +15,16 @@
  * Output: "1002"
  * Explanation: 999 + 3 = 1002.
  */
+#include "big_uint.h"
+
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
 #include <iostream>
+#include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -29,8 +36,9 @@ bool isDigitString(const std::string &s) {
   });
 }
 
-// Adds two non-negative integers represented as strings
-std::string addStrings(const std::string &num1, const std::string &num2) {
+// Adds two non-negative integers represented as strings, digit by digit
+std::string addStringsDigitwise(const std::string &num1,
+                                const std::string &num2) {
   if (!isDigitString(num1) || !isDigitString(num2)) {
     throw std::invalid_argument("Inputs must be digit strings.");
   }
@@ -56,6 +64,22 @@ std::string addStrings(const std::string &num1, const std::string &num2) {
   return result;
 }
 
+// Adds two non-negative integers represented as strings, nine digits per step
+// through BigUInt (see big_uint.h). Like the digit-wise version the result
+// is at least as wide as the wider input, so leading zeros are kept.
+std::string addStrings(const std::string &num1, const std::string &num2) {
+  std::string sum =
+      (BigUInt::fromString(num1) + BigUInt::fromString(num2)).toString();
+  const size_t width = std::max(num1.size(), num2.size());
+  if (sum.size() < width)
+    sum.insert(0, width - sum.size(), '0');
+  return sum;
+}
+
+std::string multiplyStrings(const std::string &num1, const std::string &num2) {
+  return (BigUInt::fromString(num1) * BigUInt::fromString(num2)).toString();
+}
+
 struct TestCase {
   std::string name;
   std::string num1, num2;
@@ -63,12 +87,14 @@ struct TestCase {
   std::string expected;
 };
 
-void testOptimalSolution(const std::vector<TestCase> &cases) {
-  std::cout << "=== Testing optimalSolution ===\n";
+template <typename Func>
+void testAddition(const std::string &label, const std::vector<TestCase> &cases,
+                  Func add) {
+  std::cout << "=== Testing " << label << " ===\n";
   for (const auto &tc : cases) {
     bool passed = false;
     try {
-      std::string got = addStrings(tc.num1, tc.num2);
+      std::string got = add(tc.num1, tc.num2);
       if (!tc.expectException && got == tc.expected) {
         passed = true;
       }
@@ -82,6 +108,125 @@ void testOptimalSolution(const std::vector<TestCase> &cases) {
   std::cout << "\n";
 }
 
+namespace {
+std::string randomDigits(std::mt19937 &rng, size_t n) {
+  std::string s(n, '0');
+  for (char &c : s)
+    c = static_cast<char>('0' + rng() % 10);
+  s[0] = static_cast<char>('1' + rng() % 9);
+  return s;
+}
+} // namespace
+
+// Every multiplication algorithm agrees on random operands (balanced and
+// lopsided, around the Karatsuba and NTT thresholds), and the results are
+// checked modulo a prime independently of the multiplication code.
+void testBigUInt() {
+  std::cout << "=== Testing BigUInt ===\n";
+  std::mt19937 rng(44);
+  const uint64_t prime = 1000000007;
+  using Alg = BigUInt::MulAlgorithm;
+  for (auto [da, db] : {std::pair<size_t, size_t>{1, 1}, {17, 40}, {360, 400},
+                        {400, 2000}, {3000, 3100}, {14000, 15000},
+                        {20000, 500}}) {
+    BigUInt a = BigUInt::fromString(randomDigits(rng, da));
+    BigUInt b = BigUInt::fromString(randomDigits(rng, db));
+    BigUInt reference;
+    BigUInt::multiply(a, b, reference, Alg::Schoolbook);
+    assert(reference.mod(prime) == a.mod(prime) * b.mod(prime) % prime);
+    for (Alg alg : {Alg::Karatsuba, Alg::Ntt, Alg::Auto}) {
+      BigUInt product;
+      BigUInt::multiply(a, b, product, alg);
+      assert(product == reference);
+      // A second product of the same size lands in the same buffer.
+      const auto *buffer = product.data().data();
+      BigUInt::multiply(b, a, product, alg);
+      assert(product == reference && product.data().data() == buffer);
+    }
+    assert((a + b) - b == a && (a + b).mod(prime) ==
+                                   (a.mod(prime) + b.mod(prime)) % prime);
+    assert(addStrings(a.toString(), b.toString()) ==
+           addStringsDigitwise(a.toString(), b.toString()));
+  }
+
+  // (10^k - 1)^2 = 99..9800..01 exercises long carry chains.
+  for (size_t k : {9, 10, 500, 20000}) {
+    BigUInt nines = BigUInt::fromString(std::string(k, '9'));
+    std::string expected =
+        std::string(k - 1, '9') + "8" + std::string(k - 1, '0') + "1";
+    assert((nines * nines).toString() == expected);
+  }
+
+  // Borrow across many limbs, zero handling and in-place buffer reuse.
+  BigUInt power = BigUInt::fromString("1" + std::string(100, '0'));
+  assert((power - BigUInt(1)).toString() == std::string(100, '9'));
+  assert((power - power).isZero() && (power * BigUInt()).toString() == "0");
+  bool threw = false;
+  try {
+    BigUInt(1) - BigUInt(2);
+  } catch (const std::underflow_error &) {
+    threw = true;
+  }
+  assert(threw);
+  BigUInt acc(1), out;
+  for (int i = 0; i < 50; ++i) {
+    BigUInt::multiply(acc, BigUInt(3), out);
+    std::swap(acc, out);
+  }
+  assert(acc.mod(prime) == [&] {
+    uint64_t r = 1;
+    for (int i = 0; i < 50; ++i)
+      r = r * 3 % prime;
+    return r;
+  }());
+  assert(multiplyStrings("12345678901234567890", "98765432109876543210") ==
+         "1219326311370217952237463801111263526900");
+  std::cout << "BigUInt checks passed.\n\n";
+}
+
+// Milliseconds per operation on random operands of `digits` digits.
+void benchmarkBigUInt(const std::vector<size_t> &sizes) {
+  using Alg = BigUInt::MulAlgorithm;
+  std::mt19937 rng(45);
+  auto ms = [](auto &&fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+  };
+  std::cout << "=== BigUInt (ms) ===\n"
+            << "   digits    parse   format  add-str  add-big   school  "
+               "karatsuba      ntt     auto\n"
+            << std::fixed << std::setprecision(2);
+  for (size_t digits : sizes) {
+    std::string x = randomDigits(rng, digits), y = randomDigits(rng, digits);
+    BigUInt a, b, product;
+    double parse = ms([&] { a = BigUInt::fromString(x); });
+    b = BigUInt::fromString(y);
+    std::string formatted;
+    double format = ms([&] { formatted = a.toString(); });
+    assert(formatted == x);
+    double addStr = ms([&] { formatted = addStringsDigitwise(x, y); });
+    double addBig = ms([&] { a += b; });
+    auto timeMul = [&](Alg alg, size_t maxDigits) {
+      if (digits > maxDigits)
+        return std::string("-");
+      std::ostringstream cell;
+      cell << std::fixed << std::setprecision(2)
+           << ms([&] { BigUInt::multiply(a, b, product, alg); });
+      return cell.str();
+    };
+    std::cout << std::setw(9) << digits << std::setw(9) << parse
+              << std::setw(9) << format << std::setw(9) << addStr
+              << std::setw(9) << addBig << std::setw(9)
+              << timeMul(Alg::Schoolbook, 20000) << std::setw(11)
+              << timeMul(Alg::Karatsuba, 200000) << std::setw(9)
+              << timeMul(Alg::Ntt, 1000000) << std::setw(9)
+              << timeMul(Alg::Auto, 1000000) << "\n";
+  }
+  std::cout << "\n";
+}
+
 int main() {
   std::vector<TestCase> cases = {
       {"Simple carry", "999", "3", false, "1002"},
@@ -89,10 +234,15 @@ int main() {
       {"No carry", "123", "456", false, "579"},
       {"Zero + Zero", "0", "0", false, "0"},
       {"Leading zeros", "001", "099", false, "100"},
+      {"Leading zeros kept", "007", "0", false, "007"},
+      {"Carry past leading zeros", "0999", "1", false, "1000"},
       {"Invalid char num1", "12a3", "456", true, ""},
       {"Invalid char num2", "123", "4b6", true, ""}};
 
-  testOptimalSolution(cases);
+  testAddition("addStringsDigitwise", cases, addStringsDigitwise);
+  testAddition("addStrings (BigUInt)", cases, addStrings);
+  testBigUInt();
+  benchmarkBigUInt({1000, 10000, 100000, 1000000});
   std::cout << "All tests passed successfully!\n";
   return 0;
 }
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+// Timing helpers shared by the benchmarks in this directory.
+
+// Throughput of one call to fn() over `bytes` bytes of input, in GB/s.
+template <typename Fn> double gbPerSecond(std::size_t bytes, Fn &&fn) {
+  const auto t0 = std::chrono::steady_clock::now();
+  fn();
+  const auto t1 = std::chrono::steady_clock::now();
+  return static_cast<double>(bytes) /
+         std::chrono::duration<double>(t1 - t0).count() / 1e9;
+}
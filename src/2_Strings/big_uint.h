@@ -0,0 +1,411 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Arbitrary-precision unsigned integer with base 10^9 limbs (little endian).
+//
+// A decimal base makes parsing and formatting linear: every limb is exactly
+// nine digits, so no radix conversion (and no divide-and-conquer) is needed.
+// Multiplication picks an algorithm by operand size:
+//   - schoolbook below kKaratsubaLimbs,
+//   - Karatsuba (three half-size products) up to kNttLimbs,
+//   - number-theoretic transforms modulo three NTT primes beyond that. The
+//     CRT recombination is exact while every convolution term stays below
+//     the primes' product (~7.9e25); the 2^23-point transform limit of the
+//     first prime caps products at 2^23 limbs (~75 million digits).
+// += and -= work on the existing limb buffer; *= needs a separate output
+// and swaps it in. multiply(a, b, out) writes the product into out's
+// existing buffer on every path (Karatsuba still allocates its
+// subproducts). With parallel = true the three prime convolutions of every
+// NTT product run on separate threads.
+class BigUInt {
+public:
+  using Limb = std::uint32_t;
+  static constexpr Limb kBase = 1000000000;
+  static constexpr std::size_t kDigitsPerLimb = 9;
+  static constexpr std::size_t kKaratsubaLimbs = 40;
+  static constexpr std::size_t kNttLimbs = 1500;
+
+  enum class MulAlgorithm { Auto, Schoolbook, Karatsuba, Ntt };
+
+  BigUInt() = default;
+  BigUInt(std::uint64_t value) {
+    while (value != 0) {
+      limbs.push_back(static_cast<Limb>(value % kBase));
+      value /= kBase;
+    }
+  }
+
+  // Parses a non-empty string of decimal digits (leading zeros allowed).
+  static BigUInt fromString(std::string_view digits) {
+    if (digits.empty() || !std::all_of(digits.begin(), digits.end(),
+                                       [](char c) {
+                                         return c >= '0' && c <= '9';
+                                       }))
+      throw std::invalid_argument("Inputs must be digit strings.");
+    BigUInt result;
+    result.limbs.reserve(digits.size() / kDigitsPerLimb + 1);
+    for (std::size_t end = digits.size(); end > 0;) {
+      const std::size_t begin = end > kDigitsPerLimb ? end - kDigitsPerLimb : 0;
+      Limb limb = 0;
+      for (std::size_t i = begin; i < end; ++i)
+        limb = limb * 10 + static_cast<Limb>(digits[i] - '0');
+      result.limbs.push_back(limb);
+      end = begin;
+    }
+    result.trim();
+    return result;
+  }
+
+  std::string toString() const {
+    if (limbs.empty())
+      return "0";
+    std::string out;
+    out.reserve(limbs.size() * kDigitsPerLimb);
+    char buffer[kDigitsPerLimb];
+    Limb top = limbs.back();
+    std::size_t len = 0;
+    while (top != 0) {
+      buffer[len++] = static_cast<char>('0' + top % 10);
+      top /= 10;
+    }
+    out.append(std::make_reverse_iterator(buffer + len),
+               std::make_reverse_iterator(buffer));
+    for (std::size_t i = limbs.size() - 1; i-- > 0;) {
+      Limb limb = limbs[i];
+      for (std::size_t d = kDigitsPerLimb; d-- > 0;) {
+        buffer[d] = static_cast<char>('0' + limb % 10);
+        limb /= 10;
+      }
+      out.append(buffer, kDigitsPerLimb);
+    }
+    return out;
+  }
+
+  bool isZero() const { return limbs.empty(); }
+  std::size_t limbCount() const { return limbs.size(); }
+  std::span<const Limb> data() const { return limbs; }
+
+  // Value modulo m (m > 0), for checks against modular arithmetic.
+  std::uint64_t mod(std::uint64_t m) const {
+    unsigned __int128 r = 0;
+    for (std::size_t i = limbs.size(); i-- > 0;)
+      r = (r * kBase + limbs[i]) % m;
+    return static_cast<std::uint64_t>(r);
+  }
+
+  BigUInt &operator+=(const BigUInt &other) {
+    addShifted(limbs, other.limbs, 0);
+    return *this;
+  }
+
+  // Throws std::underflow_error if other > *this.
+  BigUInt &operator-=(const BigUInt &other) {
+    if (*this < other)
+      throw std::underflow_error("BigUInt subtraction would be negative.");
+    subShifted(limbs, other.limbs, 0);
+    trim();
+    return *this;
+  }
+
+  BigUInt &operator*=(const BigUInt &other) {
+    BigUInt product;
+    multiply(*this, other, product);
+    limbs.swap(product.limbs);
+    return *this;
+  }
+
+  friend BigUInt operator+(BigUInt a, const BigUInt &b) { return a += b; }
+  friend BigUInt operator-(BigUInt a, const BigUInt &b) { return a -= b; }
+  friend BigUInt operator*(const BigUInt &a, const BigUInt &b) {
+    BigUInt product;
+    multiply(a, b, product);
+    return product;
+  }
+
+  friend bool operator==(const BigUInt &, const BigUInt &) = default;
+  friend std::strong_ordering operator<=>(const BigUInt &a, const BigUInt &b) {
+    if (a.limbs.size() != b.limbs.size())
+      return a.limbs.size() <=> b.limbs.size();
+    for (std::size_t i = a.limbs.size(); i-- > 0;) {
+      if (a.limbs[i] != b.limbs[i])
+        return a.limbs[i] <=> b.limbs[i];
+    }
+    return std::strong_ordering::equal;
+  }
+
+  // out = a * b; out must not alias a or b. Its buffer is reused.
+  static void multiply(const BigUInt &a, const BigUInt &b, BigUInt &out,
+                       MulAlgorithm algorithm = MulAlgorithm::Auto,
+                       bool parallel = false) {
+    if (&out == &a || &out == &b)
+      throw std::invalid_argument("multiply() output aliases an operand.");
+    out.limbs.clear();
+    if (a.isZero() || b.isZero())
+      return;
+    switch (algorithm) {
+    case MulAlgorithm::Schoolbook:
+      out.limbs.assign(a.limbs.size() + b.limbs.size(), 0);
+      mulSchoolbook(a.limbs, b.limbs, out.limbs.data());
+      break;
+    case MulAlgorithm::Ntt:
+      mulNtt(a.limbs, b.limbs, out.limbs, parallel);
+      break;
+    case MulAlgorithm::Karatsuba:
+    case MulAlgorithm::Auto:
+      mulRecursive(a.limbs, b.limbs, out.limbs,
+                   algorithm == MulAlgorithm::Auto, parallel);
+      break;
+    }
+    out.trim();
+  }
+
+private:
+  using Limbs = std::vector<Limb>;
+  using View = std::span<const Limb>;
+
+  void trim() { trimLimbs(limbs); }
+
+  static void trimLimbs(Limbs &v) {
+    while (!v.empty() && v.back() == 0)
+      v.pop_back();
+  }
+
+  static View trimmed(View v) {
+    while (!v.empty() && v.back() == 0)
+      v = v.first(v.size() - 1);
+    return v;
+  }
+
+  // acc += v * kBase^shift, growing acc as needed.
+  static void addShifted(Limbs &acc, View v, std::size_t shift) {
+    v = trimmed(v);
+    if (v.empty())
+      return;
+    if (acc.size() < shift + v.size())
+      acc.resize(shift + v.size(), 0);
+    Limb carry = 0;
+    std::size_t i = 0;
+    for (; i < v.size(); ++i) {
+      Limb sum = acc[shift + i] + v[i] + carry;
+      carry = sum >= kBase;
+      acc[shift + i] = carry ? sum - kBase : sum;
+    }
+    for (std::size_t k = shift + i; carry; ++k) {
+      if (k == acc.size())
+        acc.push_back(0);
+      Limb sum = acc[k] + 1;
+      carry = sum == kBase;
+      acc[k] = carry ? 0 : sum;
+    }
+  }
+
+  // acc -= v * kBase^shift; the caller guarantees the result is >= 0.
+  static void subShifted(Limbs &acc, View v, std::size_t shift) {
+    v = trimmed(v);
+    Limb borrow = 0;
+    std::size_t i = 0;
+    for (; i < v.size(); ++i) {
+      Limb sub = v[i] + borrow;
+      borrow = acc[shift + i] < sub;
+      acc[shift + i] = borrow ? acc[shift + i] + kBase - sub
+                              : acc[shift + i] - sub;
+    }
+    for (std::size_t k = shift + i; borrow; ++k) {
+      borrow = acc[k] == 0;
+      acc[k] = borrow ? kBase - 1 : acc[k] - 1;
+    }
+  }
+
+  // out[0, a.size() + b.size()) must be zeroed.
+  static void mulSchoolbook(View a, View b, Limb *out) {
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      std::uint64_t carry = 0;
+      const std::uint64_t ai = a[i];
+      for (std::size_t j = 0; j < b.size(); ++j) {
+        std::uint64_t cur = out[i + j] + ai * b[j] + carry;
+        out[i + j] = static_cast<Limb>(cur % kBase);
+        carry = cur / kBase;
+      }
+      out[i + b.size()] = static_cast<Limb>(carry);
+    }
+  }
+
+  // Karatsuba; with allowNtt, large balanced subproducts switch to NTT.
+  // Writes exactly a.size() + b.size() limbs into result, reusing its
+  // buffer. result must not alias a or b.
+  static void mulRecursive(View a, View b, Limbs &result, bool allowNtt,
+                           bool parallel) {
+    if (a.size() < b.size())
+      std::swap(a, b);
+    const std::size_t n = a.size(), m = b.size();
+    if (m == 0) {
+      result.assign(n, 0);
+      return;
+    }
+    if (m < kKaratsubaLimbs) {
+      result.assign(n + m, 0);
+      mulSchoolbook(a, b, result.data());
+      return;
+    }
+    if (allowNtt && m >= kNttLimbs) {
+      mulNtt(a, b, result, parallel);
+      result.resize(n + m, 0);
+      return;
+    }
+    result.assign(n + m, 0);
+    if (m <= n / 2) {
+      // Unbalanced: multiply b by m-limb slices of a.
+      Limbs part;
+      for (std::size_t offset = 0; offset < n; offset += m) {
+        const std::size_t len = std::min(m, n - offset);
+        mulRecursive(a.subspan(offset, len), b, part, allowNtt, parallel);
+        addShifted(result, part, offset);
+      }
+      result.resize(n + m);
+      return;
+    }
+
+    // a = a1 * B^k + a0, b = b1 * B^k + b0, with m > k.
+    const std::size_t k = n / 2;
+    View a0 = a.first(k), a1 = a.subspan(k), b0 = b.first(k), b1 = b.subspan(k);
+    Limbs z0, z1, z2;
+    mulRecursive(a0, b0, z0, allowNtt, parallel);
+    mulRecursive(a1, b1, z2, allowNtt, parallel);
+    Limbs sa(a0.begin(), a0.end()), sb(b0.begin(), b0.end());
+    addShifted(sa, a1, 0);
+    addShifted(sb, b1, 0);
+    // (a0 + a1)(b0 + b1) - z0 - z2 = a0 b1 + a1 b0
+    mulRecursive(sa, sb, z1, allowNtt, parallel);
+    subShifted(z1, z0, 0);
+    subShifted(z1, z2, 0);
+    addShifted(result, z0, 0);
+    addShifted(result, z1, k);
+    addShifted(result, z2, 2 * k);
+    result.resize(n + m); // any higher limbs are zero
+  }
+
+  template <std::uint32_t Mod> static std::uint32_t powMod(std::uint64_t base,
+                                                           std::uint64_t exp) {
+    std::uint64_t result = 1;
+    base %= Mod;
+    while (exp) {
+      if (exp & 1)
+        result = result * base % Mod;
+      base = base * base % Mod;
+      exp >>= 1;
+    }
+    return static_cast<std::uint32_t>(result);
+  }
+
+  // In-place iterative radix-2 NTT modulo Mod (primitive root 3).
+  template <std::uint32_t Mod>
+  static void ntt(std::vector<std::uint32_t> &a, bool invert) {
+    const std::size_t n = a.size();
+    for (std::size_t i = 1, j = 0; i < n; ++i) {
+      std::size_t bit = n >> 1;
+      for (; j & bit; bit >>= 1)
+        j ^= bit;
+      j ^= bit;
+      if (i < j)
+        std::swap(a[i], a[j]);
+    }
+    std::vector<std::uint32_t> roots(n / 2);
+    for (std::size_t len = 2; len <= n; len <<= 1) {
+      std::uint64_t w = powMod<Mod>(3, (Mod - 1) / len);
+      if (invert)
+        w = powMod<Mod>(w, Mod - 2);
+      const std::size_t half = len / 2;
+      roots[0] = 1;
+      for (std::size_t i = 1; i < half; ++i)
+        roots[i] = static_cast<std::uint32_t>(roots[i - 1] * w % Mod);
+      for (std::size_t i = 0; i < n; i += len) {
+        for (std::size_t j = 0; j < half; ++j) {
+          const std::uint32_t u = a[i + j];
+          const std::uint32_t v =
+              static_cast<std::uint32_t>(std::uint64_t{a[i + j + half]} *
+                                         roots[j] % Mod);
+          a[i + j] = u + v >= Mod ? u + v - Mod : u + v;
+          a[i + j + half] = u >= v ? u - v : u + Mod - v;
+        }
+      }
+    }
+    if (invert) {
+      const std::uint64_t inv = powMod<Mod>(n, Mod - 2);
+      for (auto &x : a)
+        x = static_cast<std::uint32_t>(x * inv % Mod);
+    }
+  }
+
+  // Cyclic convolution of a and b modulo Mod, length n (a power of two).
+  template <std::uint32_t Mod>
+  static std::vector<std::uint32_t> convolve(View a, View b, std::size_t n) {
+    std::vector<std::uint32_t> fa(n, 0), fb(n, 0);
+    for (std::size_t i = 0; i < a.size(); ++i)
+      fa[i] = a[i] % Mod;
+    for (std::size_t i = 0; i < b.size(); ++i)
+      fb[i] = b[i] % Mod;
+    ntt<Mod>(fa, false);
+    ntt<Mod>(fb, false);
+    for (std::size_t i = 0; i < n; ++i)
+      fa[i] = static_cast<std::uint32_t>(std::uint64_t{fa[i]} * fb[i] % Mod);
+    ntt<Mod>(fa, true);
+    return fa;
+  }
+
+  static constexpr std::uint32_t kP1 = 998244353, kP2 = 469762049,
+                                 kP3 = 167772161;
+
+  static void mulNtt(View a, View b, Limbs &out, bool parallel = false) {
+    std::size_t n = 1;
+    while (n < a.size() + b.size())
+      n <<= 1;
+    if (n > (std::size_t{1} << 23))
+      throw std::length_error("Product too large for the NTT primes.");
+    std::vector<std::uint32_t> c1, c2, c3;
+    if (parallel) {
+      std::thread t2([&] { c2 = convolve<kP2>(a, b, n); });
+      std::thread t3([&] { c3 = convolve<kP3>(a, b, n); });
+      c1 = convolve<kP1>(a, b, n);
+      t2.join();
+      t3.join();
+    } else {
+      c1 = convolve<kP1>(a, b, n);
+      c2 = convolve<kP2>(a, b, n);
+      c3 = convolve<kP3>(a, b, n);
+    }
+
+    // Garner: x = r1 + p1 * (t2 + p2 * t3), then base-10^9 carries.
+    const std::uint64_t inv1mod2 = powMod<kP2>(kP1, kP2 - 2);
+    const std::uint64_t inv12mod3 =
+        powMod<kP3>(std::uint64_t{kP1} * kP2 % kP3, kP3 - 2);
+    const std::uint64_t p1mod3 = kP1 % kP3;
+    out.assign(a.size() + b.size(), 0);
+    unsigned __int128 carry = 0;
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      const std::uint64_t r1 = c1[i], r2 = c2[i], r3 = c3[i];
+      const std::uint64_t t2 = (r2 + kP2 - r1 % kP2) % kP2 * inv1mod2 % kP2;
+      const std::uint64_t x12mod3 = (r1 + p1mod3 * t2) % kP3;
+      const std::uint64_t t3 = (r3 + kP3 - x12mod3) % kP3 * inv12mod3 % kP3;
+      unsigned __int128 value =
+          r1 + static_cast<unsigned __int128>(kP1) *
+                   (t2 + static_cast<unsigned __int128>(kP2) * t3);
+      value += carry;
+      out[i] = static_cast<Limb>(value % kBase);
+      carry = value / kBase;
+    }
+  }
+
+  Limbs limbs; // empty means zero; no leading zero limbs
+};
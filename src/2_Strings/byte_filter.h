@@ -0,0 +1,250 @@
+#pragma once
+
+#include "simd_dispatch.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Set of byte values with a vector-friendly membership test.
+//
+// Besides a plain 256-bit table, a set keeps two 16-byte "nibble" tables:
+// for a byte b = (hi << 4) | lo, bit (hi & 7) of low[lo] (hi < 8) or of
+// high[lo] (hi >= 8) says whether b is in the set. With pshufb a vector of
+// 16 or 32 bytes looks up both tables by its low nibbles, picks one by the
+// top bit, and tests the bit selected by its high nibbles: four shuffles and
+// a few logic ops answer membership for every lane, for any set.
+class ByteSet {
+public:
+  ByteSet() = default;
+  explicit ByteSet(std::string_view bytes) {
+    for (char c : bytes)
+      add(static_cast<unsigned char>(c));
+  }
+
+  void add(unsigned char b) {
+    bits[b >> 6] |= std::uint64_t{1} << (b & 63);
+    auto &table = b < 0x80 ? low : high;
+    table[b & 0x0F] |= static_cast<std::uint8_t>(1u << ((b >> 4) & 7));
+  }
+
+  bool contains(unsigned char b) const {
+    return (bits[b >> 6] >> (b & 63)) & 1;
+  }
+
+  const std::array<std::uint8_t, 16> &lowTable() const { return low; }
+  const std::array<std::uint8_t, 16> &highTable() const { return high; }
+
+private:
+  std::array<std::uint64_t, 4> bits{};
+  alignas(16) std::array<std::uint8_t, 16> low{};
+  alignas(16) std::array<std::uint8_t, 16> high{};
+};
+
+namespace byte_filter_detail {
+inline std::size_t removeScalar(const char *in, std::size_t n, char *out,
+                                const ByteSet &set) {
+  std::size_t w = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    // Always store, advance only for kept bytes: no unpredictable branch.
+    out[w] = in[i];
+    w += !set.contains(static_cast<unsigned char>(in[i]));
+  }
+  return w;
+}
+
+inline std::size_t findFirstNotInScalar(const char *data, std::size_t n,
+                                        const ByteSet &set) {
+  std::size_t i = 0;
+  while (i < n && set.contains(static_cast<unsigned char>(data[i])))
+    ++i;
+  return i;
+}
+
+#if SIMD_DISPATCH_HAS_X86
+// shuffles[mask] moves the bytes selected by an 8-bit mask to the front.
+struct CompressShuffles {
+  std::array<std::array<std::uint8_t, 8>, 256> lanes{};
+  constexpr CompressShuffles() {
+    for (int mask = 0; mask < 256; ++mask) {
+      int k = 0;
+      for (int bit = 0; bit < 8; ++bit) {
+        if (mask & (1 << bit))
+          lanes[mask][k++] = static_cast<std::uint8_t>(bit);
+      }
+      for (; k < 8; ++k)
+        lanes[mask][k] = 0x80; // zero fill
+    }
+  }
+};
+inline constexpr CompressShuffles compressShuffles{};
+
+// Writes the bytes of v selected by keep (16 bits) to dst and returns the
+// new end. Each half is stored as a full 8-byte word; because the output
+// never runs ahead of the input, those stores stay inside the block that
+// was just loaded, so in-place filtering and exact-size outputs are safe.
+__attribute__((target("ssse3,popcnt"))) inline char *
+compressStore16(__m128i v, unsigned keep, char *dst) {
+  const unsigned lo = keep & 0xFF, hi = keep >> 8;
+  std::uint64_t loShuffle, hiShuffle;
+  __builtin_memcpy(&loShuffle, compressShuffles.lanes[lo].data(), 8);
+  __builtin_memcpy(&hiShuffle, compressShuffles.lanes[hi].data(), 8);
+  const __m128i shuffle = _mm_add_epi8(
+      _mm_set_epi64x(static_cast<long long>(hiShuffle),
+                     static_cast<long long>(loShuffle)),
+      _mm_set_epi64x(0x0808080808080808ll, 0));
+  const __m128i packed = _mm_shuffle_epi8(v, shuffle);
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), packed);
+  dst += __builtin_popcount(lo);
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(dst),
+                   _mm_unpackhi_epi64(packed, packed));
+  return dst + __builtin_popcount(hi);
+}
+
+// Bitmask (one bit per byte) of the lanes of v that are in the set.
+__attribute__((target("ssse3"))) inline unsigned
+memberMask16(__m128i v, __m128i low, __m128i high, __m128i bitOf) {
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  const __m128i lo = _mm_and_si128(v, nibble);
+  const __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+  const __m128i fromLow = _mm_shuffle_epi8(low, lo);
+  const __m128i fromHigh = _mm_shuffle_epi8(high, lo);
+  // Bytes >= 0x80 take the high table.
+  const __m128i upper = _mm_cmplt_epi8(v, _mm_setzero_si128());
+  const __m128i row = _mm_or_si128(_mm_andnot_si128(upper, fromLow),
+                                   _mm_and_si128(upper, fromHigh));
+  const __m128i hit = _mm_and_si128(row, _mm_shuffle_epi8(bitOf, hi));
+  const __m128i miss = _mm_cmpeq_epi8(hit, _mm_setzero_si128());
+  return ~static_cast<unsigned>(_mm_movemask_epi8(miss)) & 0xFFFFu;
+}
+
+__attribute__((target("avx2"))) inline unsigned
+memberMask32(__m256i v, __m256i low, __m256i high, __m256i bitOf) {
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+  const __m256i lo = _mm256_and_si256(v, nibble);
+  const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+  const __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(low, lo),
+                                         _mm256_shuffle_epi8(high, lo), v);
+  const __m256i hit = _mm256_and_si256(row, _mm256_shuffle_epi8(bitOf, hi));
+  const __m256i miss = _mm256_cmpeq_epi8(hit, _mm256_setzero_si256());
+  return ~static_cast<unsigned>(_mm256_movemask_epi8(miss));
+}
+
+inline __m128i bitOfNibble() {
+  return _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64,
+                       -128);
+}
+
+__attribute__((target("ssse3,popcnt"))) inline std::size_t
+removeSsse3(const char *in, std::size_t n, char *out, const ByteSet &set) {
+  const __m128i low = _mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(set.lowTable().data()));
+  const __m128i high = _mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(set.highTable().data()));
+  const __m128i bitOf = bitOfNibble();
+  char *dst = out;
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    const unsigned keep = ~memberMask16(v, low, high, bitOf) & 0xFFFFu;
+    dst = compressStore16(v, keep, dst);
+  }
+  const std::size_t written = static_cast<std::size_t>(dst - out);
+  return written + removeScalar(in + i, n - i, dst, set);
+}
+
+__attribute__((target("avx2,popcnt"))) inline std::size_t
+removeAvx2(const char *in, std::size_t n, char *out, const ByteSet &set) {
+  const __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(set.lowTable().data())));
+  const __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(set.highTable().data())));
+  const __m256i bitOf = _mm256_broadcastsi128_si256(bitOfNibble());
+  char *dst = out;
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    const unsigned keep = ~memberMask32(v, low, high, bitOf);
+    if (keep == 0xFFFFFFFFu) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), v);
+      dst += 32;
+      continue;
+    }
+    dst = compressStore16(_mm256_castsi256_si128(v), keep & 0xFFFF, dst);
+    dst = compressStore16(_mm256_extracti128_si256(v, 1), keep >> 16, dst);
+  }
+  const std::size_t written = static_cast<std::size_t>(dst - out);
+  return written + removeScalar(in + i, n - i, dst, set);
+}
+
+__attribute__((target("avx2"))) inline std::size_t
+findFirstNotInAvx2(const char *data, std::size_t n, const ByteSet &set) {
+  const __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(set.lowTable().data())));
+  const __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(set.highTable().data())));
+  const __m256i bitOf = _mm256_broadcastsi128_si256(bitOfNibble());
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    const unsigned outside = ~memberMask32(v, low, high, bitOf);
+    if (outside != 0)
+      return i + static_cast<std::size_t>(__builtin_ctz(outside));
+  }
+  return i + findFirstNotInScalar(data + i, n - i, set);
+}
+
+__attribute__((target("ssse3"))) inline std::size_t
+findFirstNotInSsse3(const char *data, std::size_t n, const ByteSet &set) {
+  const __m128i low = _mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(set.lowTable().data()));
+  const __m128i high = _mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(set.highTable().data()));
+  const __m128i bitOf = bitOfNibble();
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    const unsigned outside = ~memberMask16(v, low, high, bitOf) & 0xFFFFu;
+    if (outside != 0)
+      return i + static_cast<std::size_t>(__builtin_ctz(outside));
+  }
+  return i + findFirstNotInScalar(data + i, n - i, set);
+}
+#endif
+} // namespace byte_filter_detail
+
+// Copies the bytes of in[0, n) that are not in set to out and returns how
+// many were kept. out needs room for n bytes and may equal in (in-place);
+// other overlaps are not allowed. Levels the CPU lacks fall back to the
+// best supported one.
+inline std::size_t removeBytes(const char *in, std::size_t n, char *out,
+                               const ByteSet &set,
+                               SimdLevel level = detectSimdLevel()) {
+  level = supportedSimdLevel(level, kByteSimdLevels);
+#if SIMD_DISPATCH_HAS_X86
+  if (level == SimdLevel::Avx2)
+    return byte_filter_detail::removeAvx2(in, n, out, set);
+  if (level == SimdLevel::Ssse3)
+    return byte_filter_detail::removeSsse3(in, n, out, set);
+#endif
+  return byte_filter_detail::removeScalar(in, n, out, set);
+}
+
+// Index of the first byte of data[0, n) that is not in set, or n.
+inline std::size_t findFirstNotIn(const char *data, std::size_t n,
+                                  const ByteSet &set,
+                                  SimdLevel level = detectSimdLevel()) {
+  level = supportedSimdLevel(level, kByteSimdLevels);
+#if SIMD_DISPATCH_HAS_X86
+  if (level == SimdLevel::Avx2)
+    return byte_filter_detail::findFirstNotInAvx2(data, n, set);
+  if (level == SimdLevel::Ssse3)
+    return byte_filter_detail::findFirstNotInSsse3(data, n, set);
+#endif
+  return byte_filter_detail::findFirstNotInScalar(data, n, set);
+}
@@ -34,6 +34,9 @@
  *   "a"
  */
 
+#include "bench_util.h"
+#include "byte_filter.h"
+
 #include <algorithm>
 #include <bitset>
 #include <cassert>
@@ -109,6 +112,43 @@ void inplaceSolution(std::string &s) {
   s.erase(writer, s.end());
 }
 
+// 5) Vectorized skip over already-seen bytes; O(n) time, O(1) extra space.
+// At most 256 bytes are ever kept, and everything between two of them is a
+// repeat. So instead of testing byte by byte, a pshufb set-membership scan
+// (byte_filter.h) jumps to the next byte not seen yet; once all 256 values
+// have appeared the rest of the input is skipped outright. out may equal
+// data (in-place). Returns the number of bytes kept.
+size_t keepFirstOccurrences(const char *data, size_t n, char *out,
+                            SimdLevel level = detectSimdLevel()) {
+  ByteSet seen;
+  size_t kept = 0;
+  for (size_t i = 0; i < n && kept < 256; ++i) {
+    i += findFirstNotIn(data + i, n - i, seen, level);
+    if (i == n)
+      break;
+    seen.add(static_cast<unsigned char>(data[i]));
+    out[kept++] = data[i];
+  }
+  return kept;
+}
+
+std::string vectorizedSolution(const std::string &input) {
+  std::string result(std::min<size_t>(input.size(), 256), '\0');
+  result.resize(
+      keepFirstOccurrences(input.data(), input.size(), result.data()));
+  return result;
+}
+
+void vectorizedInplaceSolution(std::string &s) {
+  s.resize(keepFirstOccurrences(s.data(), s.size(), s.data()));
+}
+
+std::string vectorizedInplaceAdapter(const std::string &input) {
+  std::string s = input;
+  vectorizedInplaceSolution(s);
+  return s;
+}
+
 // Adapter to fit in the same runner
 std::string inplaceAdapter(const std::string &input) {
   std::string s = input;
@@ -213,6 +253,52 @@ std::vector<TestCase> makeRandomCases(size_t count, size_t minLen,
   return v;
 }
 
+// Every dispatch level against the reference, on random bytes covering all
+// 256 values (so the "everything seen" exit is taken) and on narrow alphabets.
+bool testLevelsRandom() {
+  std::mt19937 rng(0x46);
+  bool ok = true;
+  for (int trial = 0; trial < 200; ++trial) {
+    const int alphabet = trial % 2 ? 256 : 1 + static_cast<int>(rng() % 40);
+    std::string input(rng() % 3000, '\0');
+    for (char &c : input)
+      c = static_cast<char>(rng() % alphabet);
+    const std::string expected = referenceExpected(input);
+    for (SimdLevel level : kByteSimdLevels) {
+      std::string inplace = input;
+      inplace.resize(keepFirstOccurrences(inplace.data(), inplace.size(),
+                                          inplace.data(), level));
+      ok = ok && inplace == expected;
+    }
+  }
+  std::cout << "Randomized dispatch levels: " << (ok ? "PASS" : "FAIL")
+            << "\n\n";
+  return ok;
+}
+
+// GB/s on makeLongStressInput of the given length.
+void benchmarkDedup(size_t n) {
+  const std::string input = makeLongStressInput(n);
+  auto timed = [&](auto &&fn) {
+    std::string work = input;
+    return gbPerSecond(n, [&] { fn(work); });
+  };
+  std::cout << "=== Stress input, " << n << " bytes (GB/s) ===\n" << std::fixed
+            << std::setprecision(2);
+  std::cout << "  inplaceSolution (bitset)  "
+            << timed([](std::string &s) { inplaceSolution(s); }) << "\n";
+  for (SimdLevel level : kByteSimdLevels) {
+    std::cout << "  keepFirstOccurrences " << std::left << std::setw(7)
+              << simdLevelName(level) << std::right
+              << timed([&](std::string &s) {
+                   s.resize(keepFirstOccurrences(s.data(), s.size(), s.data(),
+                                                 level));
+                 })
+              << "\n";
+  }
+  std::cout << "\n";
+}
+
 // -------------------- Main --------------------
 
 int main() {
@@ -248,6 +334,8 @@ int main() {
       {"optimalSolution (hash)", &optimalSolution},
       {"alternativeSolution (erase)", &alternativeSolution},
       {"inplaceSolution (iterator)", &inplaceAdapter},
+      {"vectorizedSolution (pshufb)", &vectorizedSolution},
+      {"vectorizedInplace (pshufb)", &vectorizedInplaceAdapter},
   };
 
   std::vector<SuiteResult> results;
@@ -260,7 +348,9 @@ int main() {
   }
 
   // Final summary
-  bool allPassed = true;
+  bool allPassed = testLevelsRandom();
+  benchmarkDedup(100000);
+  benchmarkDedup(size_t{8} << 20);
   std::cout << "=== Overall Summary ===\n";
   for (const auto &r : results) {
     std::cout << "  " << std::left << std::setw(28) << r.solverName << " -> "
@@ -35,11 +35,19 @@
  *   "l"
  */
 
+#include "bench_util.h"
+
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstdint>
+#include <iomanip>
 #include <iostream>
 #include <limits>
+#include <random>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -92,6 +100,122 @@ char alternativeSolution(const std::string &input) {
   return '\0';
 }
 
+// Online Tracker (O(1) push and query, fixed 2.5 KiB of state)
+// Characters seen exactly once sit in an intrusive doubly linked list in
+// order of first appearance; the links are two 257-entry index arrays (slot
+// 256 is the sentinel), so nothing is allocated per character. A second
+// occurrence unlinks the character for good, and the head of the list is
+// always the first non-repeating character of the stream so far.
+class FirstUniqueTracker {
+public:
+  FirstUniqueTracker() { reset(); }
+
+  void reset() {
+    state.fill(Unseen);
+    next[kSentinel] = prev[kSentinel] = kSentinel;
+    pushed = 0;
+  }
+
+  void push(char c) {
+    const auto u = static_cast<unsigned char>(c);
+    ++pushed;
+    if (state[u] == Unseen) {
+      state[u] = Once;
+      prev[u] = prev[kSentinel];
+      next[u] = kSentinel;
+      next[prev[kSentinel]] = u;
+      prev[kSentinel] = u;
+    } else if (state[u] == Once) {
+      state[u] = Repeated;
+      next[prev[u]] = next[u];
+      prev[next[u]] = prev[u];
+    }
+  }
+
+  void push(std::string_view chunk) {
+    for (char c : chunk)
+      push(c);
+  }
+
+  bool hasUnique() const { return next[kSentinel] != kSentinel; }
+
+  // First non-repeating character so far, or '\0' if there is none.
+  char query() const {
+    return hasUnique() ? static_cast<char>(next[kSentinel]) : '\0';
+  }
+
+  uint64_t size() const { return pushed; }
+
+private:
+  enum State : uint8_t { Unseen, Once, Repeated };
+  static constexpr uint16_t kSentinel = 256;
+
+  std::array<State, 256> state;
+  std::array<uint16_t, 257> next, prev;
+  uint64_t pushed = 0;
+};
+
+// Parallel Chunked Solution (O(n / threads + 256 * threads))
+// Each thread summarizes its chunk as a (first index, count) table. Tables
+// of consecutive chunks merge exactly: counts add (saturating at 2, all
+// that matters) and the earlier chunk's first index wins. The answer is the
+// character with count 1 and the smallest first index.
+struct OccurrenceTable {
+  static constexpr uint64_t kAbsent = std::numeric_limits<uint64_t>::max();
+  std::array<uint64_t, 256> first;
+  std::array<uint8_t, 256> count{};
+
+  OccurrenceTable() { first.fill(kAbsent); }
+
+  // Records chunk, whose first byte is at `offset` in the whole input.
+  void add(std::string_view chunk, uint64_t offset) {
+    for (size_t i = 0; i < chunk.size(); ++i) {
+      const auto u = static_cast<unsigned char>(chunk[i]);
+      if (count[u] == 0)
+        first[u] = offset + i;
+      count[u] = static_cast<uint8_t>(std::min(count[u] + 1, 2));
+    }
+  }
+
+  // `later` must describe input that comes after everything in *this.
+  void merge(const OccurrenceTable &later) {
+    for (int c = 0; c < 256; ++c) {
+      if (count[c] == 0)
+        first[c] = later.first[c];
+      count[c] = static_cast<uint8_t>(std::min(count[c] + later.count[c], 2));
+    }
+  }
+
+  char firstUnique() const {
+    int best = -1;
+    for (int c = 0; c < 256; ++c) {
+      if (count[c] == 1 && (best < 0 || first[c] < first[best]))
+        best = c;
+    }
+    return best < 0 ? '\0' : static_cast<char>(best);
+  }
+};
+
+char parallelSolution(std::string_view input, unsigned threads = 0) {
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<OccurrenceTable> tables(threads);
+  auto work = [&](unsigned t) {
+    const size_t begin = input.size() * t / threads;
+    const size_t end = input.size() * (t + 1) / threads;
+    tables[t].add(input.substr(begin, end - begin), begin);
+  };
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; ++t)
+    pool.emplace_back(work, t);
+  work(0);
+  for (auto &thread : pool)
+    thread.join();
+  for (unsigned t = 1; t < threads; ++t)
+    tables[0].merge(tables[t]);
+  return tables[0].firstUnique();
+}
+
 // --- Testing Infrastructure ---
 
 struct TestCase {
@@ -146,6 +270,71 @@ void testAlternative(const std::vector<TestCase> &cases) {
   std::cout << "\n";
 }
 
+void testStreaming(const std::vector<TestCase> &cases) {
+  std::cout << "=== Testing FirstUniqueTracker / parallelSolution ===\n";
+  for (const auto &tc : cases) {
+    FirstUniqueTracker tracker;
+    tracker.push(tc.input);
+    bool pass = tracker.query() == tc.expected &&
+                parallelSolution(tc.input, 2) == tc.expected;
+    std::cout << tc.name << " -> " << (pass ? "PASS" : "FAIL") << "\n";
+    assert(pass);
+  }
+
+  // After every push the tracker answers for the prefix seen so far.
+  std::mt19937 rng(47);
+  for (int trial = 0; trial < 50; ++trial) {
+    const int alphabet = 1 + trial % 12;
+    std::string input(200, ' ');
+    for (char &c : input)
+      c = static_cast<char>('a' + rng() % alphabet);
+    FirstUniqueTracker tracker;
+    for (size_t i = 0; i < input.size(); ++i) {
+      tracker.push(input[i]);
+      assert(tracker.query() == alternativeSolution(input.substr(0, i + 1)));
+    }
+    for (unsigned threads : {1u, 3u, 8u, 64u})
+      assert(parallelSolution(input, threads) == alternativeSolution(input));
+  }
+
+  // Bytes >= 0x80 and '\0' itself are ordinary characters.
+  FirstUniqueTracker tracker;
+  tracker.push(std::string_view("\xff\x80\xff", 3));
+  assert(tracker.query() == '\x80');
+  tracker.push('\x80');
+  assert(!tracker.hasUnique() && tracker.size() == 4);
+  std::cout << "Randomized checks passed.\n\n";
+}
+
+// GB/s over `bytes` bytes of text whose only unique character is at the end.
+void benchmarkFirstUnique(size_t bytes) {
+  std::string text(bytes, ' ');
+  std::mt19937 rng(48);
+  for (char &c : text)
+    c = static_cast<char>('a' + rng() % 25);
+  text.back() = 'z';
+
+  auto timed = [&](auto &&fn) {
+    return gbPerSecond(bytes, [&] {
+      [[maybe_unused]] const char got = fn();
+      assert(got == 'z');
+    });
+  };
+  const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+  std::cout << "=== First unique in " << (bytes >> 20) << " MiB (GB/s) ===\n"
+            << std::fixed << std::setprecision(2);
+  std::cout << "  alternativeSolution    "
+            << timed([&] { return alternativeSolution(text); }) << "\n";
+  std::cout << "  FirstUniqueTracker     " << timed([&] {
+    FirstUniqueTracker tracker;
+    tracker.push(text);
+    return tracker.query();
+  }) << "\n";
+  std::cout << "  parallelSolution (" << hw << ")   "
+            << timed([&] { return parallelSolution(text, hw); })
+            << "\n\n";
+}
+
 int main() {
   std::vector<TestCase> cases = {{"All unique", "abc", 'a'},
                                  {"Repeat at end", "ababac", 'c'},
@@ -156,6 +345,8 @@ int main() {
   testSimple(cases);
   testOptimal(cases);
   testAlternative(cases);
+  testStreaming(cases);
+  benchmarkFirstUnique(size_t{16} << 20);
 
   std::cout << "All tests passed successfully!\n";
   return 0;
@@ -40,17 +40,32 @@
  * Complexity:
  * - Time: O(n), single left-to-right scan.
  * - Space: O(1) auxiliary.
+ *
+ * parseNumber() below validates and converts in the same pass.
  */
 
+#include <array>
+#include <bit>
 #include <cassert>
 #include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <random>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // --- Implementation ---
 
-bool isValidNumericString(const std::string &str) {
+// Branchy reference validator (the original solution).
+bool isValidNumericStringBranchy(const std::string &str) {
   if (str.empty()) {
     return false;
   }
@@ -92,6 +107,352 @@ bool isValidNumericString(const std::string &str) {
   return seenDigit;
 }
 
+// Validating Parser (table-driven DFA, one pass)
+// Every byte is mapped to a class (digit, sign, dot, exponent mark, other)
+// and a 10 x 5 transition table drives the grammar above; the same pass
+// accumulates the value. Integer strings that fit in int64 come back
+// exactly. Everything else becomes a correctly rounded double:
+//   - up to 19 significant digits are kept in a uint64 (8 at a time with a
+//     SWAR trick when the bytes allow), plus a decimal exponent q;
+//   - m <= 2^53 and |q| <= 22 is exact in double arithmetic (Clinger);
+//   - otherwise Eisel-Lemire: m times a 128-bit approximation of 5^q gives
+//     the 53-bit result directly, from a 651-entry table built on first use;
+//   - inputs with more than 19 significant digits fall back to std::strtod.
+// Invalid input reports the position of the first offending byte (the
+// length of the string if it simply ended too early).
+struct NumberParse {
+  enum class Kind { Integer, Double, Invalid };
+  Kind kind = Kind::Invalid;
+  int64_t integer = 0;      // Kind::Integer
+  double value = 0;         // Integer and Double
+  size_t errorPosition = 0; // Kind::Invalid
+};
+
+namespace numeric_parse_detail {
+enum CharClass : uint8_t { kDigit, kSign, kDot, kExpMark, kOther, kClasses };
+enum State : uint8_t {
+  kStart,
+  kSignSeen,
+  kInt,
+  kDotAfterInt,
+  kDotNoInt,
+  kFrac,
+  kExpStart,
+  kExpSign,
+  kExpDigits,
+  kError,
+  kStates
+};
+
+constexpr std::array<uint8_t, 256> makeClassTable() {
+  std::array<uint8_t, 256> table{};
+  table.fill(kOther);
+  for (int c = '0'; c <= '9'; ++c)
+    table[c] = kDigit;
+  table['+'] = table['-'] = kSign;
+  table['.'] = kDot;
+  table['e'] = table['E'] = kExpMark;
+  return table;
+}
+constexpr std::array<uint8_t, 256> kClassOf = makeClassTable();
+
+//                      digit       sign       dot           exp        other
+constexpr uint8_t kNext[kStates][kClasses] = {
+    /* start     */ {kInt, kSignSeen, kDotNoInt, kError, kError},
+    /* sign      */ {kInt, kError, kDotNoInt, kError, kError},
+    /* int       */ {kInt, kError, kDotAfterInt, kExpStart, kError},
+    /* int.      */ {kFrac, kError, kError, kExpStart, kError},
+    /* .         */ {kFrac, kError, kError, kError, kError},
+    /* frac      */ {kFrac, kError, kError, kExpStart, kError},
+    /* e         */ {kExpDigits, kExpSign, kError, kError, kError},
+    /* e sign    */ {kExpDigits, kError, kError, kError, kError},
+    /* exp       */ {kExpDigits, kError, kError, kError, kError},
+    /* error     */ {kError, kError, kError, kError, kError}};
+
+constexpr bool accepting(uint8_t state) {
+  return state == kInt || state == kDotAfterInt || state == kFrac ||
+         state == kExpDigits;
+}
+
+// If p[0, 8) are all digits, stores their value and returns true.
+inline bool parseEightDigits(const char *p, uint64_t &out) {
+  if constexpr (std::endian::native != std::endian::little)
+    return false;
+  uint64_t v;
+  std::memcpy(&v, p, 8);
+  // Every byte in '0'..'9': high nibble 3, and adding 6 does not carry out.
+  if ((((v & 0xF0F0F0F0F0F0F0F0ull) |
+        (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))) !=
+      0x3333333333333333ull)
+    return false;
+  v -= 0x3030303030303030ull;
+  v = (v * 10) + (v >> 8); // pairs of digits
+  v = (((v & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +
+       (((v >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >>
+      32;
+  out = v;
+  return true;
+}
+
+// Little-endian multi-limb helpers, only used to build the table below.
+using Limbs = std::vector<uint32_t>;
+
+inline int bitLength(const Limbs &v) {
+  for (size_t i = v.size(); i-- > 0;) {
+    if (v[i] != 0)
+      return static_cast<int>(32 * i) + std::bit_width(v[i]);
+  }
+  return 0;
+}
+
+inline bool bitAt(const Limbs &v, int bit) {
+  return bit >= 0 && static_cast<size_t>(bit / 32) < v.size() &&
+         ((v[bit / 32] >> (bit % 32)) & 1);
+}
+
+// Bits [bitLength - 128, bitLength) of v, i.e. v normalized to 128 bits
+// (shifted left if shorter, truncated if longer).
+inline unsigned __int128 top128(const Limbs &v) {
+  const int len = bitLength(v);
+  unsigned __int128 out = 0;
+  for (int bit = len - 1; bit >= len - 128; --bit)
+    out = (out << 1) | (bitAt(v, bit) ? 1 : 0);
+  return out;
+}
+
+inline void mulSmall(Limbs &v, uint32_t factor) {
+  uint64_t carry = 0;
+  for (auto &limb : v) {
+    uint64_t cur = uint64_t{limb} * factor + carry;
+    limb = static_cast<uint32_t>(cur);
+    carry = cur >> 32;
+  }
+  if (carry)
+    v.push_back(static_cast<uint32_t>(carry));
+}
+
+inline void divSmall(Limbs &v, uint32_t divisor) {
+  uint64_t rem = 0;
+  for (size_t i = v.size(); i-- > 0;) {
+    uint64_t cur = (rem << 32) | v[i];
+    v[i] = static_cast<uint32_t>(cur / divisor);
+    rem = cur % divisor;
+  }
+}
+
+constexpr int kMinPow10 = -342, kMaxPow10 = 308;
+
+// table[2 * (q + 342)] / [+1]: high and low halves of the normalized 5^q,
+// truncated for q >= 0 and the reciprocal rounded up for q < 0.
+inline const std::vector<uint64_t> &powersOfFive() {
+  static const std::vector<uint64_t> table = [] {
+    std::vector<uint64_t> t(2 * (kMaxPow10 - kMinPow10 + 1));
+    Limbs power = {1};
+    std::vector<Limbs> positive;
+    for (int q = 0; q <= -kMinPow10; ++q) {
+      positive.push_back(power);
+      mulSmall(power, 5);
+    }
+    auto store = [&](int q, unsigned __int128 value) {
+      t[2 * (q - kMinPow10)] = static_cast<uint64_t>(value >> 64);
+      t[2 * (q - kMinPow10) + 1] = static_cast<uint64_t>(value);
+    };
+    for (int q = 0; q <= kMaxPow10; ++q)
+      store(q, top128(positive[q]));
+    for (int k = 1; k <= -kMinPow10; ++k) {
+      const int z = bitLength(positive[k]); // 2^(z-1) < 5^k < 2^z
+      const int b = k <= 27 ? z + 127 : 2 * z + 128;
+      Limbs c(b / 32 + 1, 0);
+      c[b / 32] = uint32_t{1} << (b % 32);
+      for (int i = 0; i < k; ++i)
+        divSmall(c, 5); // floor(2^b / 5^k)
+      for (size_t i = 0; i < c.size() && ++c[i] == 0; ++i) {
+      }
+      store(-k, top128(c));
+    }
+    return t;
+  }();
+  return table;
+}
+
+// Correctly rounded w * 10^q for w != 0 holding the exact significand.
+inline double eiselLemire(uint64_t w, int64_t q) {
+  if (q < kMinPow10)
+    return 0.0;
+  if (q > kMaxPow10)
+    return std::numeric_limits<double>::infinity();
+  const uint64_t *power = &powersOfFive()[2 * (q - kMinPow10)];
+  const int lz = std::countl_zero(w);
+  w <<= lz;
+  unsigned __int128 first = static_cast<unsigned __int128>(w) * power[0];
+  uint64_t hi = static_cast<uint64_t>(first >> 64);
+  uint64_t lo = static_cast<uint64_t>(first);
+  constexpr uint64_t kPrecisionMask = ~uint64_t{0} >> 55; // 52 + 3 bits
+  if ((hi & kPrecisionMask) == kPrecisionMask) {
+    const uint64_t secondHi = static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(w) * power[1]) >> 64);
+    lo += secondHi;
+    if (secondHi > lo)
+      ++hi;
+  }
+  const int upperBit = static_cast<int>(hi >> 63);
+  const int shift = upperBit + 64 - 52 - 3;
+  uint64_t mantissa = hi >> shift;
+  int32_t power2 = ((152170 + 65536) * static_cast<int32_t>(q) >> 16) + 63 +
+                   upperBit - lz + 1023;
+
+  uint64_t bits;
+  if (power2 <= 0) { // subnormal
+    if (-power2 + 1 >= 64)
+      return 0.0;
+    mantissa >>= -power2 + 1;
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    power2 = mantissa < (uint64_t{1} << 52) ? 0 : 1;
+    bits = (mantissa & ((uint64_t{1} << 52) - 1)) | uint64_t(power2) << 52;
+    return std::bit_cast<double>(bits);
+  }
+  // Exactly halfway between two doubles: round to even, not up.
+  if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 &&
+      (mantissa << shift) == hi)
+    mantissa &= ~uint64_t{1};
+  mantissa += mantissa & 1;
+  mantissa >>= 1;
+  if (mantissa >= (uint64_t{2} << 52)) {
+    mantissa = uint64_t{1} << 52;
+    ++power2;
+  }
+  mantissa &= ~(uint64_t{1} << 52);
+  if (power2 >= 0x7FF)
+    return std::numeric_limits<double>::infinity();
+  bits = mantissa | uint64_t(power2) << 52;
+  return std::bit_cast<double>(bits);
+}
+
+constexpr double kExactPowersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+} // namespace numeric_parse_detail
+
+NumberParse parseNumber(std::string_view s) {
+  using namespace numeric_parse_detail;
+  NumberParse result;
+  uint8_t state = kStart;
+  bool negative = false, expNegative = false, isInteger = true;
+  bool truncated = false;
+  uint64_t mantissa = 0;
+  int digits = 0;        // significant digits held in mantissa
+  int64_t q10 = 0;       // decimal exponent of mantissa before 'e'
+  int64_t exponent = 0;  // the explicit exponent
+  const size_t n = s.size();
+  size_t i = 0;
+  auto isDigitAt = [&](size_t k) {
+    return k < n && static_cast<unsigned char>(s[k] - '0') < 10;
+  };
+  while (i < n) {
+    const auto c = static_cast<unsigned char>(s[i]);
+    const uint8_t cls = kClassOf[c];
+    const uint8_t next = kNext[state][cls];
+    if (next == kError) {
+      result.errorPosition = i;
+      return result;
+    }
+    state = next;
+    if (cls != kDigit) {
+      if (cls == kSign)
+        (i == 0 ? negative : expNegative) = c == '-';
+      else
+        isInteger = false;
+      ++i;
+    } else if (next == kExpDigits) {
+      // Digit transitions are self-loops, so a whole run is consumed here.
+      for (; isDigitAt(i); ++i) {
+        if (exponent < 1000000000000000)
+          exponent = exponent * 10 + (s[i] - '0');
+      }
+    } else {
+      const bool frac = next == kFrac;
+      for (; mantissa == 0 && i < n && s[i] == '0'; ++i)
+        q10 -= frac; // leading zero
+      uint64_t chunk;
+      while (digits <= 11 && i + 8 <= n &&
+             parseEightDigits(s.data() + i, chunk)) {
+        mantissa = mantissa * 100000000 + chunk;
+        digits += 8;
+        q10 -= frac ? 8 : 0;
+        i += 8;
+      }
+      const size_t runStart = i;
+      for (; digits < 19 && isDigitAt(i); ++i, ++digits)
+        mantissa = mantissa * 10 + (s[i] - '0');
+      q10 -= frac ? static_cast<int64_t>(i - runStart) : 0;
+      for (; isDigitAt(i); ++i) { // beyond 19 significant digits
+        truncated |= s[i] != '0';
+        q10 += !frac;
+      }
+    }
+  }
+  if (!accepting(state)) {
+    result.errorPosition = n;
+    return result;
+  }
+
+  if (isInteger && !truncated && q10 == 0) {
+    const uint64_t limit = uint64_t{1} << 63;
+    if (mantissa < limit || (negative && mantissa == limit)) {
+      result.kind = NumberParse::Kind::Integer;
+      result.integer = negative ? static_cast<int64_t>(0 - mantissa)
+                                : static_cast<int64_t>(mantissa);
+      result.value = static_cast<double>(result.integer);
+      if (negative && mantissa == 0)
+        result.value = -0.0;
+      return result;
+    }
+  }
+
+  result.kind = NumberParse::Kind::Double;
+  const int64_t q = q10 + (expNegative ? -exponent : exponent);
+  double magnitude;
+  if (truncated) {
+    magnitude = std::strtod(std::string(s).c_str(), nullptr);
+    result.value = magnitude; // strtod already applied the sign
+    return result;
+  } else if (mantissa == 0) {
+    magnitude = 0.0;
+  } else if (mantissa <= (uint64_t{1} << 53) && q >= -22 && q <= 22) {
+    magnitude = q >= 0 ? static_cast<double>(mantissa) * kExactPowersOfTen[q]
+                       : static_cast<double>(mantissa) / kExactPowersOfTen[-q];
+  } else {
+    magnitude = eiselLemire(mantissa, q);
+  }
+  result.value = negative ? -magnitude : magnitude;
+  return result;
+}
+
+bool isValidNumericString(const std::string &str) {
+  return parseNumber(str).kind != NumberParse::Kind::Invalid;
+}
+
+// Batch API: parses every line of a '\n'-separated buffer into out (a
+// trailing newline does not start an empty last line). Returns the number
+// of invalid lines.
+size_t parseNumberLines(std::string_view buffer, std::vector<NumberParse> &out) {
+  out.clear();
+  size_t invalid = 0;
+  size_t start = 0;
+  while (start < buffer.size()) {
+    const void *nl = std::memchr(buffer.data() + start, '\n',
+                                 buffer.size() - start);
+    const size_t end = nl ? static_cast<size_t>(static_cast<const char *>(nl) -
+                                                buffer.data())
+                          : buffer.size();
+    out.push_back(parseNumber(buffer.substr(start, end - start)));
+    invalid += out.back().kind == NumberParse::Kind::Invalid;
+    start = end + 1;
+  }
+  return invalid;
+}
+
 // --- Testing Infrastructure ---
 
 struct TestCase {
@@ -114,6 +475,172 @@ void runTests(const std::vector<TestCase> &cases) {
   std::cout << "\nAll tests passed successfully!\n";
 }
 
+// The DFA must accept exactly what the branchy validator accepts.
+void testAgainstBranchy() {
+  std::mt19937 rng(48);
+  const std::string alphabet = "0123456789+-.eEx ";
+  for (int iter = 0; iter < 200000; ++iter) {
+    std::string s(rng() % 8, ' ');
+    for (auto &c : s)
+      c = alphabet[rng() % alphabet.size()];
+    assert(isValidNumericString(s) == isValidNumericStringBranchy(s));
+  }
+  std::cout << "DFA matches branchy validator on random strings: PASS\n";
+}
+
+void testParsedValues() {
+  using Kind = NumberParse::Kind;
+  auto integer = [](std::string_view s, int64_t v) {
+    NumberParse r = parseNumber(s);
+    assert(r.kind == Kind::Integer && r.integer == v);
+  };
+  integer("0", 0);
+  integer("-42", -42);
+  integer("+0007", 7);
+  integer("9223372036854775807", std::numeric_limits<int64_t>::max());
+  integer("-9223372036854775808", std::numeric_limits<int64_t>::min());
+  integer("12345678901234567", 12345678901234567); // SWAR path
+  assert(parseNumber("9223372036854775808").kind == Kind::Double);
+  assert(parseNumber("-0").kind == Kind::Integer &&
+         std::signbit(parseNumber("-0").value));
+
+  auto dbl = [](std::string_view s, double v) {
+    NumberParse r = parseNumber(s);
+    assert(r.kind == Kind::Double);
+    assert(std::bit_cast<uint64_t>(r.value) == std::bit_cast<uint64_t>(v));
+  };
+  dbl("600.", 600.0);
+  dbl("-.123", -0.123);
+  dbl("123.45e+6", 123.45e6);
+  dbl("1.484278348325E+308", 1.484278348325E+308);
+  dbl("1e309", std::numeric_limits<double>::infinity());
+  dbl("-1e-400", -0.0);
+  dbl("4.9406564584124654e-324", std::numeric_limits<double>::denorm_min());
+  dbl("2.2250738585072014e-308", std::numeric_limits<double>::min());
+  dbl("1.7976931348623157e308", std::numeric_limits<double>::max());
+  dbl("9007199254740993e0", 9007199254740992.0); // tie, rounds to even
+  dbl("0.1000000000000000055511151231257827021181583404541015625", 0.1);
+  dbl("0.000000000000000000000000000001e30", 1.0);
+
+  auto error = [](std::string_view s, size_t pos) {
+    NumberParse r = parseNumber(s);
+    assert(r.kind == Kind::Invalid && r.errorPosition == pos);
+  };
+  error("", 0);
+  error("1a3.14", 1);
+  error("+-5", 1);
+  error("11.2.3", 4);
+  error("12e", 3);
+  error("12e+", 4);
+  std::cout << "parseNumber values and error positions: PASS\n";
+}
+
+// Random doubles printed with 17 digits, and random digit strings with
+// random exponents, must convert bit-identically to std::strtod.
+void testAgainstStrtod() {
+  std::mt19937_64 rng(4848);
+  char buf[64];
+  auto check = [](const char *text) {
+    const double expected = std::strtod(text, nullptr);
+    const NumberParse r = parseNumber(text);
+    assert(r.kind != NumberParse::Kind::Invalid);
+    assert(std::bit_cast<uint64_t>(r.value) ==
+           std::bit_cast<uint64_t>(expected));
+  };
+  for (int iter = 0; iter < 100000; ++iter) {
+    double v = std::bit_cast<double>(rng());
+    if (!std::isfinite(v))
+      continue;
+    std::snprintf(buf, sizeof buf, "%.17g", v);
+    check(buf);
+  }
+  for (int iter = 0; iter < 100000; ++iter) {
+    std::string s = std::to_string(rng() >> (rng() % 64));
+    if (rng() % 2)
+      s.insert(rng() % (s.size() + 1), ".");
+    if (s == ".")
+      s = "0.";
+    s += "e" + std::to_string(static_cast<int>(rng() % 700) - 350);
+    check(s.c_str());
+  }
+  std::cout << "parseNumber bit-identical to strtod: PASS\n";
+}
+
+void testBatch() {
+  const std::string buffer = "1\n-2.5\nabc\n\n1e10\n";
+  std::vector<NumberParse> out;
+  assert(parseNumberLines(buffer, out) == 2);
+  assert(out.size() == 5);
+  assert(out[0].integer == 1 && out[1].value == -2.5);
+  assert(out[2].kind == NumberParse::Kind::Invalid &&
+         out[2].errorPosition == 0);
+  assert(out[3].kind == NumberParse::Kind::Invalid);
+  assert(out[4].value == 1e10);
+  std::cout << "parseNumberLines: PASS\n";
+}
+
+// Parses the same newline-separated buffer with std::strtod,
+// std::from_chars and parseNumberLines.
+void benchmarkParse(size_t count) {
+  std::mt19937_64 rng(2024);
+  std::string buffer;
+  std::vector<size_t> starts;
+  char buf[64];
+  for (size_t i = 0; i < count; ++i) {
+    starts.push_back(buffer.size());
+    if (i % 2)
+      buffer += std::to_string(static_cast<int64_t>(rng()) >> (rng() % 64));
+    else {
+      std::snprintf(buf, sizeof buf, "%.17g",
+                    std::ldexp(static_cast<double>(rng() >> 11), -53) *
+                        std::pow(10.0, static_cast<int>(rng() % 40) - 20));
+      buffer += buf;
+    }
+    buffer += '\n';
+  }
+
+  auto time = [&](const char *name, auto &&parseAll) {
+    auto t0 = std::chrono::steady_clock::now();
+    double checksum = parseAll();
+    auto t1 = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    std::cout << "  " << std::left << std::setw(18) << name << std::right
+              << std::setw(8) << std::fixed << std::setprecision(1)
+              << ns / static_cast<double>(count) << " ns/number  (sum "
+              << std::setprecision(3) << std::scientific << checksum << ")\n"
+              << std::defaultfloat;
+  };
+  parseNumber("1e300"); // builds the power-of-five table outside the timing
+  std::cout << "\nParsing " << count << " numbers\n";
+  time("std::strtod", [&] {
+    double sum = 0;
+    for (size_t start : starts)
+      sum += std::strtod(buffer.c_str() + start, nullptr);
+    return sum;
+  });
+  time("std::from_chars", [&] {
+    double sum = 0;
+    for (size_t start : starts) {
+      const char *first = buffer.data() + start;
+      const char *last =
+          static_cast<const char *>(std::memchr(first, '\n', 64));
+      double v = 0;
+      std::from_chars(first, last, v);
+      sum += v;
+    }
+    return sum;
+  });
+  time("parseNumberLines", [&] {
+    std::vector<NumberParse> out;
+    out.reserve(count);
+    parseNumberLines(buffer, out);
+    double sum = 0;
+    for (const auto &r : out)
+      sum += r.value;
+    return sum;
+  });
+}
+
 int main() {
   std::vector<TestCase> cases = {
       {"Integer only", "100", true},
@@ -131,5 +658,10 @@ int main() {
       {"Empty string", "", false}};
 
   runTests(cases);
+  testAgainstBranchy();
+  testParsedValues();
+  testAgainstStrtod();
+  testBatch();
+  benchmarkParse(200000);
   return 0;
 }
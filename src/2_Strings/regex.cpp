@@ -25,11 +25,32 @@
  * Matches: '.' matches 'a', '*' allows '.' to match 'b' also.
  */
 
+#include <array>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
 #include <iostream>
+#include <random>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define REGEX_HAS_MMAP 1
+#else
+#define REGEX_HAS_MMAP 0
+#endif
+
 // --- Implementations ---
 
 // Simple Recursive Solution (O(2^n))
@@ -105,6 +126,323 @@ bool optimalMatch(const std::string &s, const std::string &p) {
   return dp[m][n];
 }
 
+// Compiled Pattern (parse once, O(n) per match for up to 63 tokens)
+// The pattern is parsed once into tokens: a literal or '.', optionally
+// starred. Its NFA has one state per token boundary: state j means "the
+// first j tokens matched the text so far", and state size() accepts.
+//
+// With at most 63 tokens the state set fits one 64-bit word (Shift-And):
+// reading a character keeps every starred state whose token matches it and
+// shifts every plain one by one position. The epsilon moves "skip a starred
+// token" are runs of consecutive star bits, closed in one step with an
+// addition whose carry travels along each run. Longer patterns use the same
+// NFA with one bool per state in a single rolling DP row.
+class CompiledPattern {
+public:
+  static constexpr size_t kMaxBitParallelTokens = 63;
+
+  explicit CompiledPattern(std::string_view pattern) {
+    for (size_t i = 0; i < pattern.size(); ++i) {
+      if (pattern[i] == '*')
+        throw std::invalid_argument("'*' must follow a character or '.'");
+      const bool starred = i + 1 < pattern.size() && pattern[i + 1] == '*';
+      tokens.push_back({pattern[i], starred});
+      if (starred)
+        ++i;
+    }
+    if (bitParallel()) {
+      for (size_t j = 0; j < tokens.size(); ++j) {
+        const uint64_t bit = uint64_t{1} << j;
+        if (tokens[j].starred)
+          starMask |= bit;
+        for (int c = 0; c < 256; ++c) {
+          if (tokens[j].accepts(static_cast<char>(c)))
+            charMask[c] |= bit;
+        }
+      }
+      acceptBit = uint64_t{1} << tokens.size();
+    }
+  }
+
+  size_t size() const { return tokens.size(); }
+  bool bitParallel() const { return tokens.size() <= kMaxBitParallelTokens; }
+
+  bool matches(std::string_view text) const {
+    if (!bitParallel())
+      return matchesRow(text);
+    uint64_t state = startState();
+    for (char c : text) {
+      state = step(state, c);
+      if (state == 0)
+        return false;
+    }
+    return accepts(state);
+  }
+
+  // Bit-parallel primitives (valid when bitParallel()).
+  uint64_t startState() const { return close(1); }
+  uint64_t step(uint64_t state, char c) const {
+    const uint64_t hit = state & charMask[static_cast<unsigned char>(c)];
+    return close(((hit & ~starMask) << 1) | (hit & starMask));
+  }
+  bool accepts(uint64_t state) const { return (state & acceptBit) != 0; }
+  // Row DP primitives (any pattern length): the same automaton with one
+  // bool per state, row[j] being state j. stepRow() returns false once no
+  // state is left.
+  std::vector<char> startRow() const {
+    std::vector<char> row(tokens.size() + 1, 0);
+    row[0] = 1;
+    closeRow(row);
+    return row;
+  }
+
+  bool stepRow(std::vector<char> &row, char c) const {
+    const size_t k = tokens.size();
+    bool any = false;
+    // Descending, so row[j - 1] is still the previous character's value.
+    for (size_t j = k + 1; j-- > 0;) {
+      bool next = j < k && tokens[j].starred && row[j] && tokens[j].accepts(c);
+      if (j > 0 && !tokens[j - 1].starred && row[j - 1] &&
+          tokens[j - 1].accepts(c))
+        next = true;
+      row[j] = next;
+      any |= next;
+    }
+    closeRow(row);
+    return any;
+  }
+
+  // Characters with equal masks behave identically in every state.
+  uint64_t maskOf(char c) const {
+    return charMask[static_cast<unsigned char>(c)];
+  }
+
+private:
+  struct Token {
+    char symbol;
+    bool starred;
+    bool accepts(char c) const { return symbol == '.' || symbol == c; }
+  };
+
+  // Adds every state reachable by skipping starred tokens.
+  uint64_t close(uint64_t state) const {
+    return state | (((state & starMask) + starMask) ^ starMask);
+  }
+
+  bool matchesRow(std::string_view text) const {
+    std::vector<char> row = startRow();
+    for (char c : text) {
+      if (!stepRow(row, c))
+        return false;
+    }
+    return row.back() != 0;
+  }
+
+  void closeRow(std::vector<char> &row) const {
+    for (size_t j = 0; j < tokens.size(); ++j) {
+      if (tokens[j].starred && row[j])
+        row[j + 1] = 1;
+    }
+  }
+
+  std::vector<Token> tokens;
+  std::array<uint64_t, 256> charMask{};
+  uint64_t starMask = 0;
+  uint64_t acceptBit = 0;
+};
+
+bool compiledMatch(const std::string &s, const std::string &p) {
+  return CompiledPattern(p).matches(s);
+}
+
+// Lazy DFA (amortized O(1) per character for up to 63 tokens)
+// DFA states are the NFA state sets of a CompiledPattern, discovered on
+// demand: a missing transition is computed once with step() and then read
+// from a table. Bytes with identical token masks share one column, so the
+// table is (states x byte classes) rather than (states x 256). At most
+// maxStates sets are cached; when the cache is full it is flushed and
+// rebuilt from the start state, which bounds memory on pathological inputs.
+// Patterns that are not bitParallel() build no DFA: matches() falls back to
+// CompiledPattern::matches, the O(n * tokens) row DP, and caches nothing.
+// The cache is mutable: use one LazyDfa per thread over a shared pattern.
+class LazyDfa {
+public:
+  explicit LazyDfa(const CompiledPattern &pattern, size_t maxStates = 4096)
+      : pattern(pattern), maxStates(std::max<size_t>(maxStates, 2)) {
+    std::vector<uint64_t> classMasks;
+    for (int c = 0; c < 256; ++c) {
+      const uint64_t mask = pattern.maskOf(static_cast<char>(c));
+      size_t cls = 0;
+      while (cls < classMasks.size() && classMasks[cls] != mask)
+        ++cls;
+      if (cls == classMasks.size())
+        classMasks.push_back(mask);
+      classOf[c] = static_cast<uint8_t>(cls);
+    }
+    classCount = classMasks.size();
+    if (pattern.bitParallel())
+      flush();
+  }
+
+  LazyDfa(CompiledPattern &&, size_t = 4096) = delete;
+
+  bool matches(std::string_view text) {
+    if (!pattern.bitParallel())
+      return pattern.matches(text);
+    uint32_t state = start;
+    for (char c : text) {
+      const uint8_t cls = classOf[static_cast<unsigned char>(c)];
+      int32_t next = table[state * classCount + cls];
+      state = next >= 0 ? static_cast<uint32_t>(next) : transition(state, c);
+      if (sets[state] == 0)
+        return false;
+    }
+    return pattern.accepts(sets[state]);
+  }
+
+  size_t cachedStates() const { return sets.size(); }
+  size_t flushes() const { return flushCount; }
+  size_t byteClasses() const { return classCount; }
+
+private:
+  uint32_t transition(uint32_t state, char c) {
+    const uint64_t nextSet = pattern.step(sets[state], c);
+    auto it = index.find(nextSet);
+    if (it != index.end()) {
+      table[state * classCount + classOf[static_cast<unsigned char>(c)]] =
+          static_cast<int32_t>(it->second);
+      return it->second;
+    }
+    if (sets.size() == maxStates) {
+      ++flushCount;
+      flush(); // `state` is gone, so this edge is not recorded
+      return intern(nextSet);
+    }
+    uint32_t id = intern(nextSet);
+    table[state * classCount + classOf[static_cast<unsigned char>(c)]] =
+        static_cast<int32_t>(id);
+    return id;
+  }
+
+  uint32_t intern(uint64_t set) {
+    auto [it, inserted] =
+        index.emplace(set, static_cast<uint32_t>(sets.size()));
+    if (inserted) {
+      sets.push_back(set);
+      table.resize(sets.size() * classCount, -1);
+    }
+    return it->second;
+  }
+
+  void flush() {
+    sets.clear();
+    table.clear();
+    index.clear();
+    start = intern(pattern.startState());
+  }
+
+  const CompiledPattern &pattern;
+  size_t maxStates;
+  std::array<uint8_t, 256> classOf{};
+  size_t classCount = 0;
+  std::vector<uint64_t> sets;  // NFA state set of each DFA state
+  std::vector<int32_t> table;  // state * classCount + class -> state, -1
+  std::unordered_map<uint64_t, uint32_t> index;
+  uint32_t start = 0;
+  size_t flushCount = 0;
+};
+
+static_assert(!std::is_constructible_v<LazyDfa, CompiledPattern>);
+
+// Batch Matching
+// Subject i is buffer[offsets[i], offsets[i + 1]); out[i] is 1 if it
+// matches. Threads take contiguous ranges of subjects, each with a private
+// LazyDfa over the shared, read-only pattern. Patterns longer than 63
+// tokens get no DFA, so each subject then costs the row DP's O(n * tokens).
+void matchBatch(const CompiledPattern &pattern, std::string_view buffer,
+                std::span<const size_t> offsets, std::span<uint8_t> out,
+                unsigned threads = 1) {
+  if (offsets.empty() || out.size() != offsets.size() - 1 ||
+      offsets.back() > buffer.size())
+    throw std::invalid_argument("offsets must hold out.size() + 1 entries.");
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  const size_t count = out.size();
+  auto work = [&](unsigned t) {
+    LazyDfa dfa(pattern);
+    const size_t first = count * t / threads, last = count * (t + 1) / threads;
+    for (size_t i = first; i < last; ++i)
+      out[i] = dfa.matches(
+          buffer.substr(offsets[i], offsets[i + 1] - offsets[i]));
+  };
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; ++t)
+    pool.emplace_back(work, t);
+  work(0);
+  for (auto &thread : pool)
+    thread.join();
+}
+
+// Streaming Matching (O(pattern) memory, input in any number of chunks)
+// Carries the NFA state across feed() calls, so a subject never has to be
+// held in memory; finish() tells whether everything fed so far matches.
+// Once no state is alive the rest of the input is only counted.
+class StreamingMatcher {
+public:
+  explicit StreamingMatcher(const CompiledPattern &pattern) : pattern(pattern) {
+    reset();
+  }
+
+  StreamingMatcher(CompiledPattern &&) = delete;
+
+  void reset() {
+    if (pattern.bitParallel())
+      bits = pattern.startState();
+    else
+      row = pattern.startRow();
+    alive = true;
+    consumed = 0;
+  }
+
+  void feed(std::span<const char> chunk) {
+    consumed += chunk.size();
+    if (!alive)
+      return;
+    if (pattern.bitParallel()) {
+      uint64_t state = bits;
+      for (char c : chunk) {
+        state = pattern.step(state, c);
+        if (state == 0)
+          break;
+      }
+      bits = state;
+      alive = state != 0;
+    } else {
+      for (char c : chunk) {
+        if (!(alive = pattern.stepRow(row, c)))
+          break;
+      }
+    }
+  }
+
+  bool finish() const {
+    if (!alive)
+      return false;
+    return pattern.bitParallel() ? pattern.accepts(bits) : row.back() != 0;
+  }
+
+  uint64_t bytesConsumed() const { return consumed; }
+
+private:
+  const CompiledPattern &pattern;
+  uint64_t bits = 0;
+  std::vector<char> row;
+  bool alive = true;
+  uint64_t consumed = 0;
+};
+
+static_assert(!std::is_constructible_v<StreamingMatcher, CompiledPattern>);
+
 // --- Test infrastructure ---
 
 struct TestCase {
@@ -130,6 +468,283 @@ void runTests(const std::string &label, const std::vector<TestCase> &cases,
   std::cout << "\n";
 }
 
+// Random subjects and patterns over a tiny alphabet hit many '*'/'.'
+// interactions; both matcher paths must agree with optimalMatch. Long
+// patterns are built from short ones padded with "x*" to force the row DP.
+void testCompiledRandom() {
+  std::cout << "=== Randomized CompiledPattern vs optimalMatch ===\n";
+  std::mt19937 rng(41);
+  auto randomString = [&](size_t maxLen, const std::string &alphabet) {
+    std::string out(rng() % (maxLen + 1), ' ');
+    for (char &c : out)
+      c = alphabet[rng() % alphabet.size()];
+    return out;
+  };
+  auto randomPattern = [&](size_t maxTokens) {
+    std::string p;
+    size_t tokens = rng() % (maxTokens + 1);
+    for (size_t i = 0; i < tokens; ++i) {
+      p += "ab."[rng() % 3];
+      if (rng() % 2)
+        p += '*';
+    }
+    return p;
+  };
+  for (int trial = 0; trial < 3000; ++trial) {
+    std::string p = randomPattern(8);
+    CompiledPattern compiled(p);
+    std::string padded;
+    for (size_t i = 0; i < 70; ++i)
+      padded += "x*";
+    padded += p;
+    CompiledPattern longPattern(padded);
+    assert(compiled.bitParallel() && !longPattern.bitParallel());
+    for (int k = 0; k < 10; ++k) {
+      std::string s = randomString(12, "ab");
+      const bool expected = optimalMatch(s, p);
+      assert(compiled.matches(s) == expected);
+      assert(longPattern.matches(s) == expected);
+    }
+  }
+
+  bool threw = false;
+  try {
+    CompiledPattern invalid("*a");
+  } catch (const std::invalid_argument &) {
+    threw = true;
+  }
+  assert(threw);
+  std::cout << "Randomized checks passed.\n\n";
+}
+
+// The lazy DFA, also with a cache small enough to flush constantly, and
+// the batch API at several thread counts agree with CompiledPattern.
+void testLazyDfa() {
+  std::cout << "=== Testing LazyDfa / matchBatch ===\n";
+  std::mt19937 rng(42);
+  for (int trial = 0; trial < 300; ++trial) {
+    std::string p;
+    for (size_t i = rng() % 9; i > 0; --i) {
+      p += "abc."[rng() % 4];
+      if (rng() % 2)
+        p += '*';
+    }
+    CompiledPattern compiled(p);
+    LazyDfa dfa(compiled), tiny(compiled, 2);
+
+    std::string buffer;
+    std::vector<size_t> offsets = {0};
+    std::vector<uint8_t> expected;
+    for (int k = 0; k < 40; ++k) {
+      std::string s(rng() % 16, ' ');
+      for (char &c : s)
+        c = "abc"[rng() % 3];
+      expected.push_back(compiled.matches(s));
+      assert(dfa.matches(s) == expected.back());
+      assert(tiny.matches(s) == expected.back());
+      buffer += s;
+      offsets.push_back(buffer.size());
+    }
+    assert(tiny.cachedStates() <= 2);
+    for (unsigned threads : {1u, 3u}) {
+      std::vector<uint8_t> got(expected.size());
+      matchBatch(compiled, buffer, offsets, got, threads);
+      assert(got == expected);
+    }
+  }
+  std::cout << "Randomized checks passed.\n\n";
+}
+
+// Throughput of the batch API on many short strings in one buffer.
+void benchmarkBatch(size_t count) {
+  CompiledPattern pattern("a*b.*c*d.e*");
+  std::mt19937 rng(10);
+  std::string buffer;
+  std::vector<size_t> offsets = {0};
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t len = 4 + rng() % 12; len > 0; --len)
+      buffer += "abcde"[rng() % 5];
+    offsets.push_back(buffer.size());
+  }
+  std::vector<uint8_t> out(count);
+
+  auto mStringsPerSecond = [&](auto &&fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return static_cast<double>(count) /
+           std::chrono::duration<double>(t1 - t0).count() / 1e6;
+  };
+  const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+
+  std::cout << "=== Batch of " << count << " short strings (M strings/s) ===\n"
+            << std::fixed << std::setprecision(2);
+  std::cout << "  CompiledPattern loop  " << mStringsPerSecond([&] {
+    for (size_t i = 0; i < count; ++i)
+      out[i] = pattern.matches(std::string_view(buffer).substr(
+          offsets[i], offsets[i + 1] - offsets[i]));
+  }) << "\n";
+  std::cout << "  matchBatch, 1 thread  " << mStringsPerSecond([&] {
+    matchBatch(pattern, buffer, offsets, out, 1);
+  }) << "\n";
+  std::cout << "  matchBatch, " << std::setw(2) << hw << " thr.  "
+            << mStringsPerSecond(
+                   [&] { matchBatch(pattern, buffer, offsets, out, hw); })
+            << "\n\n";
+}
+
+// Strings per second for one pattern against many subjects.
+void benchmarkCompiled(size_t count) {
+  const std::string pattern = "a*b.*c*d.e*";
+  std::mt19937 rng(9);
+  std::vector<std::string> subjects(count);
+  for (auto &s : subjects) {
+    s.resize(8 + rng() % 24);
+    for (char &c : s)
+      c = "abcde"[rng() % 5];
+  }
+
+  auto mStringsPerSecond = [&](auto &&fn) {
+    size_t hits = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (const auto &s : subjects)
+      hits += fn(s);
+    auto t1 = std::chrono::steady_clock::now();
+    volatile size_t sink = hits;
+    (void)sink;
+    return static_cast<double>(count) /
+           std::chrono::duration<double>(t1 - t0).count() / 1e6;
+  };
+
+  CompiledPattern compiled(pattern);
+  std::string longPattern;
+  for (int i = 0; i < 30; ++i)
+    longPattern += "x*";
+  longPattern += pattern;
+  longPattern += "z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*";
+  CompiledPattern rowDp(longPattern);
+
+  std::cout << "=== \"" << pattern << "\" vs " << count
+            << " strings (M strings/s) ===\n"
+            << std::fixed << std::setprecision(2);
+  std::cout << "  optimalMatch          " << mStringsPerSecond([&](auto &s) {
+    return optimalMatch(s, pattern);
+  }) << "\n";
+  std::cout << "  CompiledPattern       " << mStringsPerSecond([&](auto &s) {
+    return compiled.matches(s);
+  }) << "\n";
+  std::cout << "  CompiledPattern (row) " << mStringsPerSecond([&](auto &s) {
+    return rowDp.matches(s);
+  }) << "  [" << rowDp.size() << " tokens]\n\n";
+}
+
+// Feeding a subject in random pieces (including empty ones) gives the same
+// answer as optimalMatch on the whole string, for both matcher paths.
+void testStreaming() {
+  std::cout << "=== Testing StreamingMatcher ===\n";
+  std::mt19937 rng(43);
+  for (int trial = 0; trial < 500; ++trial) {
+    std::string p;
+    for (size_t i = rng() % 8; i > 0; --i) {
+      p += "ab."[rng() % 3];
+      if (rng() % 2)
+        p += '*';
+    }
+    std::string padded;
+    for (int i = 0; i < 70; ++i)
+      padded += "x*";
+    padded += p;
+    CompiledPattern compiled(p), longPattern(padded);
+    assert(!longPattern.bitParallel());
+    StreamingMatcher stream(compiled), longStream(longPattern);
+
+    for (int k = 0; k < 10; ++k) {
+      std::string s(rng() % 40, ' ');
+      for (char &c : s)
+        c = "ab"[rng() % 2];
+      stream.reset();
+      longStream.reset();
+      for (size_t pos = 0; pos <= s.size();) {
+        size_t len = std::min<size_t>(rng() % 6, s.size() - pos);
+        std::span<const char> piece(s.data() + pos, len);
+        stream.feed(piece);
+        longStream.feed(piece);
+        pos += len;
+        if (len == 0 && pos == s.size())
+          break;
+      }
+      const bool expected = optimalMatch(s, p);
+      assert(stream.finish() == expected && longStream.finish() == expected);
+      assert(stream.bytesConsumed() == s.size());
+    }
+  }
+  std::cout << "Randomized checks passed.\n\n";
+}
+
+// Streams a generated file through the matcher in 64 KiB chunks, from an
+// mmap'd view where available (otherwise from memory).
+void benchmarkStreaming(size_t bytes) {
+  std::string data(bytes, ' ');
+  std::mt19937 rng(11);
+  for (char &c : data)
+    c = static_cast<char>('a' + rng() % 16); // 'a'..'p'
+  data[bytes / 2] = 'q';
+
+  // Streams the first `length` bytes (the 'q' sits in the middle of the
+  // file, so only a full pass must match).
+  auto gbPerSecond = [&](const CompiledPattern &pattern, const char *view,
+                         size_t length) {
+    StreamingMatcher stream(pattern);
+    constexpr size_t kChunk = 64 * 1024;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t pos = 0; pos < length; pos += kChunk)
+      stream.feed({view + pos, std::min(kChunk, length - pos)});
+    bool matched = stream.finish();
+    auto t1 = std::chrono::steady_clock::now();
+    assert(matched == (length > bytes / 2));
+    return static_cast<double>(length) /
+           std::chrono::duration<double>(t1 - t0).count() / 1e9;
+  };
+
+  const char *view = data.data();
+  std::string source = "memory";
+#if REGEX_HAS_MMAP
+  char path[] = "/tmp/regex_streamXXXXXX";
+  int fd = mkstemp(path);
+  void *mapped = MAP_FAILED;
+  if (fd >= 0 && write(fd, data.data(), bytes) == static_cast<ssize_t>(bytes))
+    mapped = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (mapped != MAP_FAILED) {
+    view = static_cast<const char *>(mapped);
+    source = "mmap";
+  }
+#endif
+
+  std::string longPattern;
+  for (int i = 0; i < 70; ++i)
+    longPattern += "x*";
+  longPattern += ".*q.*";
+  std::cout << "=== Streaming " << bytes / (1 << 20) << " MiB from " << source
+            << " (GB/s) ===\n"
+            << std::fixed << std::setprecision(3);
+  std::cout << "  bit-parallel \".*q.*\"  "
+            << gbPerSecond(CompiledPattern(".*q.*"), view, bytes) << "\n";
+  // The row DP is O(tokens) per byte; a prefix is enough to time it.
+  std::cout << "  row DP (" << CompiledPattern(longPattern).size()
+            << " tokens)     "
+            << gbPerSecond(CompiledPattern(longPattern), view, bytes / 32)
+            << "\n\n";
+
+#if REGEX_HAS_MMAP
+  if (mapped != MAP_FAILED)
+    munmap(mapped, bytes);
+  if (fd >= 0) {
+    close(fd);
+    unlink(path);
+  }
+#endif
+}
+
 int main() {
   std::vector<TestCase> cases = {
       {"Match c*a*b", "aab", "c*a*b", true},
@@ -141,6 +756,13 @@ int main() {
 
   runTests("simpleMatch", cases, simpleMatch);
   runTests("optimalMatch", cases, optimalMatch);
+  runTests("compiledMatch", cases, compiledMatch);
+  testCompiledRandom();
+  benchmarkCompiled(30000);
+  testLazyDfa();
+  benchmarkBatch(1000000);
+  testStreaming();
+  benchmarkStreaming(8 << 20);
 
   std::cout << "All tests passed successfully!\n";
   return 0;
@@ -37,10 +37,18 @@
  * Output:
  *   "nospace"
  */
+#include "bench_util.h"
+#include "simd_dispatch.h"
+
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <random>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // --- Implementations ---
@@ -123,6 +131,274 @@ void optimalSolution(char str[], size_t capacity) {
   }
 }
 
+// Vectorized Solution (SIMD count + block-wise back-to-front expansion)
+// Spaces are counted 16 or 32 bytes at a time (compare, movemask, popcount).
+// The backward pass then moves whole blocks: a block without spaces is one
+// load and one store; otherwise each 8-byte half goes through a pshufb whose
+// control word (one of 256, indexed by the half's space mask) interleaves
+// the source bytes with "%20" and right-aligns the up to 24 output bytes.
+// The leading bytes of that 24-byte store are scratch that later halves
+// overwrite, so it is only used while it cannot reach unread input; near the
+// front of the buffer the loop finishes with the scalar code. Once all
+// spaces are expanded (write position == read position) the remaining
+// prefix is already in place and the pass stops early.
+// Time Complexity: O(n). Space Complexity: O(1).
+namespace url_encode_detail {
+inline std::size_t countSpacesScalar(const char *data, std::size_t n) {
+  return static_cast<std::size_t>(std::count(data, data + n, ' '));
+}
+
+// Expands src[0, i) into dst[0, j), j = i + 2 * spaces, back to front.
+// dst may equal src.
+inline void expandScalar(const char *src, std::size_t i, char *dst,
+                         std::size_t j) {
+  while (i > 0 && (src != dst || j > i)) {
+    --i;
+    if (src[i] == ' ') {
+      dst[--j] = '0';
+      dst[--j] = '2';
+      dst[--j] = '%';
+    } else {
+      dst[--j] = src[i];
+    }
+  }
+}
+
+#if SIMD_DISPATCH_HAS_X86
+struct ExpandShuffles {
+  std::array<std::array<std::uint8_t, 24>, 256> lanes{};
+  constexpr ExpandShuffles() {
+    for (int mask = 0; mask < 256; ++mask) {
+      std::uint8_t sequence[24] = {};
+      int k = 0;
+      for (int bit = 0; bit < 8; ++bit) {
+        if (mask & (1 << bit)) {
+          sequence[k++] = 8; // lanes 8..10 hold "%20"
+          sequence[k++] = 9;
+          sequence[k++] = 10;
+        } else {
+          sequence[k++] = static_cast<std::uint8_t>(bit);
+        }
+      }
+      for (int lane = 0; lane < 24; ++lane)
+        lanes[mask][lane] = lane < 24 - k ? 0x80 : sequence[lane - (24 - k)];
+    }
+  }
+};
+inline constexpr ExpandShuffles expandShuffles{};
+
+// Encodes the 8 bytes at src (space mask `mask`) so that they end at
+// dstEnd, storing 24 bytes in total. Returns the encoded length.
+__attribute__((target("ssse3,popcnt"))) inline std::size_t
+expand8(const char *src, unsigned mask, char *dstEnd) {
+  const __m128i bytes = _mm_unpacklo_epi64(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src)),
+      _mm_setr_epi8('%', '2', '0', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+  const auto &lanes = expandShuffles.lanes[mask];
+  const __m128i first =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes.data()));
+  const __m128i second =
+      _mm_loadl_epi64(reinterpret_cast<const __m128i *>(lanes.data() + 16));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dstEnd - 24),
+                   _mm_shuffle_epi8(bytes, first));
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(dstEnd - 8),
+                   _mm_shuffle_epi8(bytes, second));
+  return 8 + 2 * static_cast<std::size_t>(__builtin_popcount(mask));
+}
+
+// One 16-byte block ending at src + i with space mask `mask`, high half
+// first. The 24-byte stores must not reach below dst or, in place, below
+// the half being encoded.
+__attribute__((target("ssse3,popcnt"))) inline void
+expandBlock16(const char *src, std::size_t &i, char *dst, std::size_t &j,
+              unsigned mask) {
+  const bool inPlace = src == dst;
+  for (unsigned half : {mask >> 8, mask & 0xFF}) {
+    if (inPlace ? j - i >= 16 : j >= 24) {
+      j -= expand8(src + i - 8, half, dst + j);
+      i -= 8;
+    } else {
+      const std::size_t stop = i - 8;
+      while (i > stop) {
+        --i;
+        if (src[i] == ' ') {
+          j -= 3;
+          std::memcpy(dst + j, "%20", 3);
+        } else {
+          dst[--j] = src[i];
+        }
+      }
+    }
+  }
+}
+
+__attribute__((target("popcnt"))) inline std::size_t
+countSpacesSse2(const char *data, std::size_t n) {
+  const __m128i space = _mm_set1_epi8(' ');
+  std::size_t count = 0, i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    count += static_cast<std::size_t>(
+        __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(v, space))));
+  }
+  return count + countSpacesScalar(data + i, n - i);
+}
+
+__attribute__((target("avx2,popcnt"))) inline std::size_t
+countSpacesAvx2(const char *data, std::size_t n) {
+  const __m256i space = _mm256_set1_epi8(' ');
+  std::size_t count = 0, i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    count += static_cast<std::size_t>(__builtin_popcount(
+        static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, space)))));
+  }
+  return count + countSpacesSse2(data + i, n - i);
+}
+
+__attribute__((target("ssse3,popcnt"))) inline void
+expandSsse3(const char *src, std::size_t i, char *dst, std::size_t j) {
+  const __m128i space = _mm_set1_epi8(' ');
+  while (i >= 16 && (src != dst || j > i)) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i - 16));
+    const auto mask =
+        static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, space)));
+    if (mask == 0) {
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j - 16), v);
+      i -= 16;
+      j -= 16;
+    } else {
+      expandBlock16(src, i, dst, j, mask);
+    }
+  }
+  expandScalar(src, i, dst, j);
+}
+
+__attribute__((target("avx2,popcnt"))) inline void
+expandAvx2(const char *src, std::size_t i, char *dst, std::size_t j) {
+  const __m256i space = _mm256_set1_epi8(' ');
+  while (i >= 32 && (src != dst || j > i)) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i - 32));
+    const auto mask = static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, space)));
+    if (mask == 0) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + j - 32), v);
+      i -= 32;
+      j -= 32;
+    } else {
+      expandBlock16(src, i, dst, j, mask >> 16);
+      expandBlock16(src, i, dst, j, mask & 0xFFFF);
+    }
+  }
+  expandSsse3(src, i, dst, j);
+}
+#endif
+} // namespace url_encode_detail
+
+inline std::size_t countSpaces(const char *data, std::size_t n,
+                               SimdLevel level = detectSimdLevel()) {
+  level = supportedSimdLevel(level, kByteSimdLevels);
+#if SIMD_DISPATCH_HAS_X86
+  if (level == SimdLevel::Avx2)
+    return url_encode_detail::countSpacesAvx2(data, n);
+  if (level == SimdLevel::Ssse3)
+    return url_encode_detail::countSpacesSse2(data, n);
+#endif
+  return url_encode_detail::countSpacesScalar(data, n);
+}
+
+// Writes the encoding of src[0, n) to dst[0, n + 2 * spaces) and returns
+// its length; spaces must be the number of ' ' in the input. dst may equal
+// src (in-place), other overlaps are not allowed.
+inline std::size_t encodeSpaces(const char *src, std::size_t n, char *dst,
+                                std::size_t spaces,
+                                SimdLevel level = detectSimdLevel()) {
+  level = supportedSimdLevel(level, kByteSimdLevels);
+  const std::size_t length = n + 2 * spaces;
+#if SIMD_DISPATCH_HAS_X86
+  if (level == SimdLevel::Avx2) {
+    url_encode_detail::expandAvx2(src, n, dst, length);
+    return length;
+  }
+  if (level == SimdLevel::Ssse3) {
+    url_encode_detail::expandSsse3(src, n, dst, length);
+    return length;
+  }
+#endif
+  url_encode_detail::expandScalar(src, n, dst, length);
+  return length;
+}
+
+// Same contract as optimalSolution.
+void vectorizedSolution(char str[], size_t capacity,
+                        SimdLevel level = detectSimdLevel()) {
+  if (!str || capacity == 0)
+    return;
+  const size_t origLen = std::strlen(str);
+  const size_t newLen = origLen + 2 * countSpaces(str, origLen, level);
+  if (newLen >= capacity)
+    return;
+  str[newLen] = '\0';
+  encodeSpaces(str, origLen, str, (newLen - origLen) / 2, level);
+}
+
+// Streaming Encoder (bounded output buffer)
+// For inputs that do not fit in memory: feed chunks of any size, encoded
+// bytes collect in a fixed buffer that is handed to the sink whenever the
+// next piece would not fit, and once more from flush(). Memory use is the
+// buffer, independent of the input length.
+class UrlEncodeStream {
+public:
+  using Sink = std::function<void(std::string_view)>;
+
+  explicit UrlEncodeStream(Sink sink, std::size_t bufferBytes = 64 << 10,
+                           SimdLevel level = detectSimdLevel())
+      : sink(std::move(sink)), buffer(std::max<std::size_t>(bufferBytes, 3)),
+        level(level) {}
+
+  void write(std::string_view chunk) {
+    while (!chunk.empty()) {
+      const std::size_t room = buffer.size() - used;
+      std::size_t take = std::min(chunk.size(), room);
+      std::size_t spaces = countSpaces(chunk.data(), take, level);
+      if (take + 2 * spaces > room) {
+        take = room / 3; // fits even if every byte is a space
+        spaces = countSpaces(chunk.data(), take, level);
+      }
+      if (take == 0) {
+        flushBuffer();
+        continue;
+      }
+      used += encodeSpaces(chunk.data(), take, buffer.data() + used, spaces,
+                           level);
+      chunk.remove_prefix(take);
+    }
+  }
+
+  void flush() { flushBuffer(); }
+
+  std::size_t bytesWritten() const { return written + used; }
+
+private:
+  void flushBuffer() {
+    if (used != 0)
+      sink(std::string_view(buffer.data(), used));
+    written += used;
+    used = 0;
+  }
+
+  Sink sink;
+  std::vector<char> buffer;
+  std::size_t used = 0;
+  std::size_t written = 0;
+  SimdLevel level;
+};
+
 // --- Testing Infrastructure ---
 
 struct StrTestCase {
@@ -166,6 +442,98 @@ void testOptimal(const std::vector<CStrTestCase> &cases) {
   std::cout << "\n";
 }
 
+// Random texts (including long space runs and no-space stretches) through
+// every level, in place and through the streaming encoder.
+void testVectorizedRandom() {
+  std::cout << "=== Testing vectorizedSolution / UrlEncodeStream ===\n";
+  std::mt19937 rng(49);
+  for (int iter = 0; iter < 300; ++iter) {
+    const size_t n = rng() % 300;
+    const unsigned spaceOdds = 1 + rng() % 8;
+    std::string text(n, 'x');
+    for (auto &c : text)
+      c = rng() % spaceOdds == 0 ? ' ' : static_cast<char>('a' + rng() % 26);
+    const std::string expected = simpleSolution(text);
+
+    for (SimdLevel level : kByteSimdLevels) {
+      assert(countSpaces(text.data(), n, level) ==
+             static_cast<size_t>(std::count(text.begin(), text.end(), ' ')));
+      std::vector<char> buffer(3 * n + 1, '#');
+      std::memcpy(buffer.data(), text.c_str(), n + 1);
+      vectorizedSolution(buffer.data(), buffer.size(), level);
+      assert(std::string(buffer.data()) == expected);
+      // Too small a buffer leaves the input untouched, like optimalSolution.
+      std::vector<char> tight(text.c_str(), text.c_str() + n + 1);
+      vectorizedSolution(tight.data(), tight.size(), level);
+      assert(expected.size() == n || std::string(tight.data()) == text);
+
+      std::string streamed;
+      UrlEncodeStream stream(
+          [&](std::string_view piece) { streamed.append(piece); },
+          3 + rng() % 64, level);
+      for (size_t pos = 0; pos < n;) {
+        const size_t len = std::min<size_t>(n - pos, rng() % 40);
+        stream.write(std::string_view(text).substr(pos, len));
+        pos += len;
+      }
+      assert(stream.bytesWritten() == expected.size());
+      stream.flush();
+      assert(streamed == expected);
+    }
+  }
+  std::cout << "Random texts, all levels: PASS\n\n";
+}
+
+// Throughput in input GB/s on text with one space per ~6 bytes.
+void benchmarkEncode(size_t bytes) {
+  const std::string chunk = "Mr John Smith and the streaming encoder ";
+  std::string text;
+  while (text.size() < bytes)
+    text += chunk;
+  text.resize(bytes);
+  const auto spaces =
+      static_cast<size_t>(std::count(text.begin(), text.end(), ' '));
+
+  std::cout << "\n=== Encode spaces, " << (bytes >> 20) << " MiB (GB/s) ===\n"
+            << std::fixed << std::setprecision(2);
+  const size_t small = std::min<size_t>(bytes, 64 << 10);
+  std::cout << "  alternativeSolution (64 KiB) "
+            << gbPerSecond(small, [&] {
+                 alternativeSolution(text.substr(0, small));
+               })
+            << "\n";
+  std::cout << "  simpleSolution               "
+            << gbPerSecond(bytes, [&] { simpleSolution(text); }) << "\n";
+  std::vector<char> buffer(bytes + 2 * spaces + 1);
+  auto reset = [&] { std::memcpy(buffer.data(), text.c_str(), bytes + 1); };
+  reset();
+  std::cout << "  optimalSolution              "
+            << gbPerSecond(bytes, [&] {
+                 optimalSolution(buffer.data(), buffer.size());
+               })
+            << "\n";
+  for (SimdLevel level : kByteSimdLevels) {
+    reset();
+    std::cout << "  vectorizedSolution " << std::left << std::setw(10)
+              << simdLevelName(level) << std::right << gbPerSecond(bytes, [&] {
+                   vectorizedSolution(buffer.data(), buffer.size(), level);
+                 })
+              << "\n";
+  }
+  size_t checksum = 0;
+  UrlEncodeStream stream([&](std::string_view piece) {
+    checksum += piece.size();
+  });
+  std::cout << "  UrlEncodeStream (64 KiB out) "
+            << gbPerSecond(bytes, [&] {
+                 for (size_t pos = 0; pos < bytes; pos += 1 << 20)
+                   stream.write(std::string_view(text).substr(pos, 1 << 20));
+                 stream.flush();
+               })
+            << "\n";
+  assert(checksum == bytes + 2 * spaces);
+}
+
 int main() {
   std::vector<StrTestCase> stringCases = {
       {"Single space", "hello world", "hello%20world"},
@@ -183,7 +551,9 @@ int main() {
   runStringTests("simpleSolution", stringCases, simpleSolution);
   runStringTests("alternativeSolution", stringCases, alternativeSolution);
   testOptimal(cstrCases);
+  testVectorizedRandom();
 
   std::cout << "All tests passed successfully!\n";
+  benchmarkEncode(size_t{8} << 20);
   return 0;
 }
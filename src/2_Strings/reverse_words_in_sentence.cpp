@@ -46,13 +46,35 @@
  *   "c b a"
  */
 
+#include "bench_util.h"
+#include "simd_dispatch.h"
+
 #include <algorithm>
 #include <cassert>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <random>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define REVERSE_WORDS_HAS_MMAP 1
+#else
+#define REVERSE_WORDS_HAS_MMAP 0
+#endif
+
 // Simple (Brute-force) Solution using string splitting.
 std::string simpleSolution(const std::string &input) {
   std::istringstream iss(input);
@@ -132,6 +154,247 @@ std::string alternativeSolution(const std::string &input) {
   return result;
 }
 
+// In-place Engine (SIMD boundaries, one compaction pass, vector reversal)
+// Same two-step trick as optimalSolution, on a raw buffer and without the
+// normalizeSpaces copy. Whitespace (the ASCII bytes std::istringstream
+// splits on) is classified 64 bytes at a time into a bitmask, so finding
+// the next word start or end is a shift and a count-trailing-zeros. A
+// single forward pass slides each word left over the collapsed whitespace,
+// reverses it in place and writes one ' ' between words; reversing the
+// whole compacted prefix then restores each word's spelling and reverses
+// the word order. Long byte ranges are reversed by swapping 32- or 16-byte
+// blocks from both ends through a pshufb byte-reverse.
+// Time Complexity: O(n). Space Complexity: O(1).
+namespace reverse_words_detail {
+inline bool isWhitespace(unsigned char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Bit k set iff data[k] is whitespace, for k < n <= 64.
+inline std::uint64_t whitespaceMaskScalar(const char *data, std::size_t n) {
+  std::uint64_t mask = 0;
+  for (std::size_t k = 0; k < n; ++k)
+    mask |= std::uint64_t{isWhitespace(static_cast<unsigned char>(data[k]))}
+            << k;
+  return mask;
+}
+
+#if SIMD_DISPATCH_HAS_X86
+inline unsigned whitespaceMask16(__m128i v) {
+  // ' ' or '\t'..'\r' (9..13): v - 9 <= 4 as unsigned bytes.
+  const __m128i shifted = _mm_sub_epi8(v, _mm_set1_epi8(9));
+  const __m128i control =
+      _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted);
+  return static_cast<unsigned>(_mm_movemask_epi8(
+      _mm_or_si128(control, _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')))));
+}
+
+inline std::uint64_t whitespaceMaskSse2(const char *data) {
+  std::uint64_t mask = 0;
+  for (int k = 0; k < 4; ++k)
+    mask |= std::uint64_t{whitespaceMask16(_mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(data + 16 * k)))}
+            << (16 * k);
+  return mask;
+}
+
+__attribute__((target("avx2"))) inline std::uint32_t
+whitespaceMask32(const char *data) {
+  const __m256i v =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+  const __m256i shifted = _mm256_sub_epi8(v, _mm256_set1_epi8(9));
+  const __m256i control = _mm256_cmpeq_epi8(
+      _mm256_min_epu8(shifted, _mm256_set1_epi8(4)), shifted);
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(
+      _mm256_or_si256(control, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')))));
+}
+
+__attribute__((target("avx2"))) inline std::uint64_t
+whitespaceMaskAvx2(const char *data) {
+  return whitespaceMask32(data) |
+         std::uint64_t{whitespaceMask32(data + 32)} << 32;
+}
+
+__attribute__((target("ssse3"))) inline void
+reverseSsse3(char *first, std::size_t n) {
+  const __m128i reverse =
+      _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  for (; n >= 32; first += 16, n -= 32) {
+    char *last = first + n - 16;
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<__m128i *>(first));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<__m128i *>(last));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(first),
+                     _mm_shuffle_epi8(b, reverse));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(last),
+                     _mm_shuffle_epi8(a, reverse));
+  }
+  std::reverse(first, first + n);
+}
+
+__attribute__((target("avx2"))) inline __m256i reverse32(__m256i v) {
+  const __m256i reverse = _mm256_setr_epi8(
+      15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, //
+      15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, reverse), 0x4E);
+}
+
+__attribute__((target("avx2"))) inline void reverseAvx2(char *first,
+                                                        std::size_t n) {
+  for (; n >= 64; first += 32, n -= 64) {
+    char *last = first + n - 32;
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<__m256i *>(first));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<__m256i *>(last));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(first), reverse32(b));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(last), reverse32(a));
+  }
+  reverseSsse3(first, n);
+}
+#endif
+
+// Walks data[0, n) in 64-byte blocks, keeping the whitespace mask of the
+// current one. Positions at or after the last query must not have been
+// modified since their block was classified.
+class BoundaryScanner {
+public:
+  BoundaryScanner(const char *data, std::size_t n, SimdLevel level)
+      : data(data), n(n), level(level) {}
+
+  // First position >= pos whose whitespace-ness equals `space`, or n.
+  std::size_t next(std::size_t pos, bool space) {
+    while (pos < n) {
+      if (pos - blockStart >= 64)
+        load(pos & ~std::size_t{63});
+      std::uint64_t hits = space ? mask : ~mask;
+      hits >>= pos - blockStart;
+      if (blockStart + 64 > n) // ignore bits past the end
+        hits &= (~std::uint64_t{0}) >> (64 - (n - pos));
+      if (hits != 0)
+        return pos + static_cast<std::size_t>(std::countr_zero(hits));
+      pos = blockStart + 64;
+    }
+    return n;
+  }
+
+private:
+  void load(std::size_t start) {
+    blockStart = start;
+#if SIMD_DISPATCH_HAS_X86
+    if (start + 64 <= n && level == SimdLevel::Avx2) {
+      mask = whitespaceMaskAvx2(data + start);
+      return;
+    }
+    if (start + 64 <= n && level == SimdLevel::Ssse3) {
+      mask = whitespaceMaskSse2(data + start);
+      return;
+    }
+#endif
+    mask = whitespaceMaskScalar(data + start,
+                                std::min<std::size_t>(64, n - start));
+  }
+
+  const char *data;
+  std::size_t n;
+  SimdLevel level;
+  std::size_t blockStart = ~std::size_t{0} - 63; // no block loaded
+  std::uint64_t mask = 0;
+};
+} // namespace reverse_words_detail
+
+inline void reverseBytes(char *first, std::size_t n,
+                         SimdLevel level = detectSimdLevel()) {
+  level = supportedSimdLevel(level, kByteSimdLevels);
+#if SIMD_DISPATCH_HAS_X86
+  if (n >= 32 && level == SimdLevel::Avx2)
+    return reverse_words_detail::reverseAvx2(first, n);
+  if (n >= 32 && level == SimdLevel::Ssse3)
+    return reverse_words_detail::reverseSsse3(first, n);
+#endif
+  std::reverse(first, first + n);
+}
+
+// Reverses the word order of data[0, n) in place, collapsing whitespace
+// runs to one ' ' and dropping leading/trailing whitespace. Returns the
+// new length; bytes past it are left unspecified.
+std::size_t reverseWordsInPlace(char *data, std::size_t n,
+                                SimdLevel level = detectSimdLevel()) {
+  level = supportedSimdLevel(level, kByteSimdLevels);
+  reverse_words_detail::BoundaryScanner scanner(data, n, level);
+  std::size_t write = 0;
+  std::size_t read = scanner.next(0, false);
+  while (read < n) {
+    const std::size_t end = scanner.next(read, true);
+    if (write != 0)
+      data[write++] = ' '; // write < read here: a separator was skipped
+    const std::size_t length = end - read;
+    if (write != read && length < 16) {
+      for (std::size_t k = 0; k < length; ++k) // forward copy, write < read
+        data[write + k] = data[read + k];
+    } else if (write != read) {
+      std::memmove(data + write, data + read, length);
+    }
+    reverseBytes(data + write, length, level);
+    write += length;
+    read = scanner.next(end, false);
+  }
+  reverseBytes(data, write, level);
+  return write;
+}
+
+std::string vectorizedSolution(const std::string &input) {
+  std::string str = input;
+  str.resize(reverseWordsInPlace(str.data(), str.size()));
+  return str;
+}
+
+// File mode: reverses the words of a file in place through a shared memory
+// mapping, so multi-megabyte documents are never copied into the heap, then
+// truncates the file to the new length. Returns that length; throws
+// std::runtime_error if the file cannot be opened, mapped or resized.
+// Without mmap the file is read into memory instead.
+std::size_t reverseWordsInFile(const std::string &path,
+                               SimdLevel level = detectSimdLevel()) {
+#if REVERSE_WORDS_HAS_MMAP
+  const int fd = open(path.c_str(), O_RDWR);
+  if (fd < 0)
+    throw std::runtime_error("Cannot open " + path);
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw std::runtime_error("Cannot stat " + path);
+  }
+  const auto size = static_cast<std::size_t>(info.st_size);
+  std::size_t length = 0;
+  if (size != 0) {
+    void *mapped =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Cannot map " + path);
+    }
+    length = reverseWordsInPlace(static_cast<char *>(mapped), size, level);
+    munmap(mapped, size);
+  }
+  const bool resized = ftruncate(fd, static_cast<off_t>(length)) == 0;
+  close(fd);
+  if (!resized)
+    throw std::runtime_error("Cannot resize " + path);
+  return length;
+#else
+  std::string text;
+  {
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+      throw std::runtime_error("Cannot open " + path);
+    text.assign(std::istreambuf_iterator<char>(in), {});
+  }
+  text.resize(reverseWordsInPlace(text.data(), text.size(), level));
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.write(text.data(), static_cast<std::streamsize>(text.size())))
+    throw std::runtime_error("Cannot write " + path);
+  return text.size();
+#endif
+}
+
 // --- Test case struct ---
 struct TestCase {
   std::string name;
@@ -154,6 +417,96 @@ void runTests(const std::string &label, const std::vector<TestCase> &cases,
   std::cout << "\n";
 }
 
+// Random texts with every kind of whitespace, through all levels, plus
+// reverseBytes on lengths around the block sizes.
+void testInPlaceRandom() {
+  std::cout << "=== Testing reverseWordsInPlace ===\n";
+  std::mt19937 rng(50);
+  const std::string spaces = " \t\n\r\v\f";
+  for (int iter = 0; iter < 300; ++iter) {
+    std::string text(rng() % 400, 'x');
+    const unsigned spaceOdds = 2 + rng() % 30;
+    for (auto &c : text)
+      c = rng() % spaceOdds == 0 ? spaces[rng() % spaces.size()]
+                                 : static_cast<char>('!' + rng() % 94);
+    const std::string expected = simpleSolution(text);
+    for (SimdLevel level : kByteSimdLevels) {
+      std::string work = text;
+      work.resize(reverseWordsInPlace(work.data(), work.size(), level));
+      assert(work == expected);
+
+      std::string bytes = text, reversed = text;
+      reverseBytes(bytes.data(), bytes.size(), level);
+      std::reverse(reversed.begin(), reversed.end());
+      assert(bytes == reversed);
+    }
+  }
+  std::cout << "Random texts, all levels: PASS\n";
+
+#if REVERSE_WORDS_HAS_MMAP
+  char path[] = "/tmp/reverse_wordsXXXXXX";
+  const int fd = mkstemp(path);
+  assert(fd >= 0);
+  close(fd);
+#else
+  const char *path = "reverse_words_test.txt";
+#endif
+  {
+    std::ofstream(path, std::ios::binary) << "  the sky\tis\n\nblue  ";
+  }
+  assert(reverseWordsInFile(path) == 15);
+  std::ifstream in(path, std::ios::binary);
+  const std::string got(std::istreambuf_iterator<char>(in), {});
+  assert(got == "blue is sky the");
+  std::remove(path);
+  std::cout << "File mode: PASS\n\n";
+}
+
+// Reverses the words of a multi-megabyte document (GB/s of input).
+void benchmarkReverse(size_t bytes) {
+  std::mt19937 rng(2024);
+  std::string text;
+  text.reserve(bytes);
+  while (text.size() < bytes) {
+    text.append(1 + rng() % 10, static_cast<char>('a' + rng() % 26));
+    text.append(rng() % 8 == 0 ? 2 : 1, ' ');
+  }
+  text.resize(bytes);
+
+  std::cout << "\n=== Reverse words, " << (bytes >> 20) << " MiB (GB/s) ===\n"
+            << std::fixed << std::setprecision(2);
+  std::string expected;
+  std::cout << "  optimalSolution            "
+            << gbPerSecond(bytes, [&] { expected = optimalSolution(text); })
+            << "\n";
+  for (SimdLevel level : kByteSimdLevels) {
+    std::string work = text;
+    size_t length = 0;
+    auto run = [&] {
+      length = reverseWordsInPlace(work.data(), work.size(), level);
+    };
+    std::cout << "  reverseWordsInPlace " << std::left << std::setw(7)
+              << simdLevelName(level) << std::right << gbPerSecond(bytes, run)
+              << "\n";
+    assert(std::string_view(work.data(), length) == expected);
+  }
+
+#if REVERSE_WORDS_HAS_MMAP
+  char path[] = "/tmp/reverse_wordsXXXXXX";
+  const int fd = mkstemp(path);
+  if (fd < 0)
+    return;
+  const bool written =
+      write(fd, text.data(), bytes) == static_cast<ssize_t>(bytes);
+  close(fd);
+  if (written)
+    std::cout << "  reverseWordsInFile (mmap)  "
+              << gbPerSecond(bytes, [&] { reverseWordsInFile(path); })
+              << "\n";
+  unlink(path);
+#endif
+}
+
 int main() {
   std::vector<TestCase> cases = {
       {"Two words", "hello world", "world hello"},
@@ -166,7 +519,10 @@ int main() {
   runTests("simpleSolution", cases, simpleSolution);
   runTests("optimalSolution", cases, optimalSolution);
   runTests("alternativeSolution", cases, alternativeSolution);
+  runTests("vectorizedSolution", cases, vectorizedSolution);
+  testInPlaceRandom();
 
   std::cout << "All tests passed successfully!\n";
+  benchmarkReverse(size_t{8} << 20);
   return 0;
 }
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_DISPATCH_HAS_X86 1
+#else
+#define SIMD_DISPATCH_HAS_X86 0
+#endif
+
+// Instruction-set levels for the runtime-dispatched kernels in this repo:
+// the byte-oriented string kernels in this directory (byte filtering, space
+// encoding, word reversal) and the int min/argmin kernels in
+// 1_Arrays/simd_min.h.
+//
+// Every kernel has a portable scalar version plus vector versions compiled
+// with target attributes, so the binary runs on any x86-64 CPU. Each kernel
+// family implements only some of the levels and lists them; a requested
+// level resolves to the best level of the family that is not above the
+// request and that the CPU supports. Tests and benchmarks request every
+// level of a family in turn.
+enum class SimdLevel { Scalar, Ssse3, Sse41, Avx2 };
+
+inline constexpr std::array<SimdLevel, 4> kSimdLevels = {
+    SimdLevel::Scalar, SimdLevel::Ssse3, SimdLevel::Sse41, SimdLevel::Avx2};
+
+// Levels implemented by the byte-oriented kernels in this directory.
+inline constexpr std::array<SimdLevel, 3> kByteSimdLevels = {
+    SimdLevel::Scalar, SimdLevel::Ssse3, SimdLevel::Avx2};
+
+inline const char *simdLevelName(SimdLevel level) {
+  static const char *const names[] = {"scalar", "ssse3", "sse4.1", "avx2"};
+  return names[static_cast<int>(level)];
+}
+
+// Whether the running CPU can execute code compiled for `level`.
+inline bool supports(SimdLevel level) {
+#if SIMD_DISPATCH_HAS_X86
+  switch (level) {
+  case SimdLevel::Scalar:
+    return true;
+  case SimdLevel::Ssse3:
+    return __builtin_cpu_supports("ssse3");
+  case SimdLevel::Sse41:
+    return __builtin_cpu_supports("sse4.1");
+  case SimdLevel::Avx2:
+    return __builtin_cpu_supports("avx2");
+  }
+  return false;
+#else
+  return level == SimdLevel::Scalar;
+#endif
+}
+
+// Best level the CPU supports; the default request of every kernel.
+inline SimdLevel detectSimdLevel() {
+  static const SimdLevel level = [] {
+    for (auto it = kSimdLevels.rbegin(); it != kSimdLevels.rend(); ++it)
+      if (supports(*it))
+        return *it;
+    return SimdLevel::Scalar;
+  }();
+  return level;
+}
+
+// Best level of `family` (ascending, starting with Scalar) that is not above
+// `requested` and that the CPU supports.
+template <std::size_t N>
+SimdLevel supportedSimdLevel(SimdLevel requested,
+                             const std::array<SimdLevel, N> &family) {
+  for (auto it = family.rbegin(); it != family.rend(); ++it)
+    if (*it <= requested && supports(*it))
+      return *it;
+  return SimdLevel::Scalar;
+}
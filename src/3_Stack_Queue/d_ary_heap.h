@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Allocator that places the heap storage on a cache-line boundary, so that
+// the D children of a node (which DAryHeap stores in one aligned group) never
+// straddle two lines when D * sizeof(T) <= 64.
+template <typename T> struct CacheAlignedAllocator {
+  using value_type = T;
+  static constexpr std::size_t alignment = 64;
+
+  CacheAlignedAllocator() = default;
+  template <typename U>
+  CacheAlignedAllocator(const CacheAlignedAllocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t(alignment)));
+  }
+
+  void deallocate(T *p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t(alignment));
+  }
+
+  template <typename U>
+  bool operator==(const CacheAlignedAllocator<U> &) const noexcept {
+    return true;
+  }
+};
+
+// D-ary heap with the same ordering convention as std::priority_queue:
+// with Compare = std::less<T> the largest element is on top.
+//
+// A wider fan-out halves (D = 4) or thirds (D = 8) the depth of a binary
+// heap, and all children of a node are scanned from one contiguous group.
+// Storage is shifted by D - 1 slots, so the children of logical node i start
+// at physical index D * (i + 1): every child group is D-aligned inside the
+// cache-aligned buffer.
+//
+// Beyond std::priority_queue it offers reserve(), bulk heapify from a range
+// (Floyd's O(n) construction) and replace_top() (pop + push with one sift).
+template <typename T, std::size_t D = 4, typename Compare = std::less<T>>
+class DAryHeap {
+  static_assert(D >= 2, "A heap needs at least two children per node");
+
+public:
+  DAryHeap() : data(D - 1) {}
+  explicit DAryHeap(Compare cmp) : data(D - 1), cmp(std::move(cmp)) {}
+
+  template <typename It> DAryHeap(It first, It last, Compare cmp = Compare{})
+      : data(D - 1), cmp(std::move(cmp)) {
+    assign(first, last);
+  }
+
+  bool empty() const { return size() == 0; }
+  std::size_t size() const { return data.size() - (D - 1); }
+  void reserve(std::size_t n) { data.reserve(n + D - 1); }
+  void clear() { data.resize(D - 1); }
+
+  const T &top() const {
+    if (empty())
+      throw std::out_of_range("top() on empty heap");
+    return at(0);
+  }
+
+  void push(const T &value) {
+    data.push_back(value);
+    siftUp(size() - 1);
+  }
+
+  void pop() {
+    if (empty())
+      throw std::out_of_range("pop() on empty heap");
+    at(0) = std::move(data.back());
+    data.pop_back();
+    if (!empty())
+      siftDown(0);
+  }
+
+  // Replaces the top element and restores the heap with one sift-down.
+  void replace_top(const T &value) {
+    if (empty())
+      throw std::out_of_range("replace_top() on empty heap");
+    at(0) = value;
+    siftDown(0);
+  }
+
+  // Replaces the contents with [first, last) and heapifies in O(n).
+  template <typename It> void assign(It first, It last) {
+    clear();
+    data.insert(data.end(), first, last);
+    heapify();
+  }
+
+  void heapify() {
+    const std::size_t n = size();
+    if (n < 2)
+      return;
+    for (std::size_t i = (n - 2) / D + 1; i-- > 0;)
+      siftDown(i);
+  }
+
+private:
+  T &at(std::size_t i) { return data[i + D - 1]; }
+  const T &at(std::size_t i) const { return data[i + D - 1]; }
+
+  void siftUp(std::size_t i) {
+    T value = std::move(at(i));
+    while (i > 0) {
+      std::size_t parent = (i - 1) / D;
+      if (!cmp(at(parent), value))
+        break;
+      at(i) = std::move(at(parent));
+      i = parent;
+    }
+    at(i) = std::move(value);
+  }
+
+  void siftDown(std::size_t i) {
+    const std::size_t n = size();
+    T value = std::move(at(i));
+    while (true) {
+      std::size_t first = D * i + 1;
+      if (first >= n)
+        break;
+      std::size_t last = std::min(first + D, n);
+      std::size_t best = first;
+      for (std::size_t c = first + 1; c < last; ++c) {
+        if (cmp(at(best), at(c)))
+          best = c;
+      }
+      if (!cmp(value, at(best)))
+        break;
+      at(i) = std::move(at(best));
+      i = best;
+    }
+    at(i) = std::move(value);
+  }
+
+  std::vector<T, CacheAlignedAllocator<T>> data;
+  Compare cmp;
+};
+
+// Indexed variant: every element carries an id in [0, capacity) and the heap
+// tracks where each id lives, so a key can be changed in O(D log_D n).
+// decreaseKey() moves an element towards the top (for a min-heap built with
+// std::greater this is the classic Dijkstra decrease-key); updateKey()
+// accepts a change in either direction.
+template <typename T, std::size_t D = 4, typename Compare = std::less<T>>
+class IndexedDAryHeap {
+  static_assert(D >= 2, "A heap needs at least two children per node");
+
+public:
+  explicit IndexedDAryHeap(std::size_t capacity, Compare cmp = Compare{})
+      : keys(capacity), position(capacity, npos), cmp(std::move(cmp)) {
+    heap.reserve(capacity);
+  }
+
+  bool empty() const { return heap.empty(); }
+  std::size_t size() const { return heap.size(); }
+  bool contains(std::size_t id) const {
+    return id < position.size() && position[id] != npos;
+  }
+
+  std::size_t topId() const {
+    if (empty())
+      throw std::out_of_range("topId() on empty heap");
+    return heap.front();
+  }
+  const T &top() const { return keys[topId()]; }
+  const T &key(std::size_t id) const { return keys.at(id); }
+
+  void push(std::size_t id, const T &value) {
+    if (id >= position.size())
+      throw std::out_of_range("id exceeds heap capacity");
+    if (contains(id))
+      throw std::invalid_argument("id is already in the heap");
+    keys[id] = value;
+    position[id] = heap.size();
+    heap.push_back(id);
+    siftUp(heap.size() - 1);
+  }
+
+  void pop() {
+    std::size_t id = topId();
+    moveTo(heap.back(), 0);
+    heap.pop_back();
+    position[id] = npos;
+    if (!heap.empty())
+      siftDown(0);
+  }
+
+  void decreaseKey(std::size_t id, const T &value) {
+    if (!contains(id))
+      throw std::invalid_argument("id is not in the heap");
+    if (cmp(value, keys[id]))
+      throw std::invalid_argument("decreaseKey() would move the key down");
+    keys[id] = value;
+    siftUp(position[id]);
+  }
+
+  void updateKey(std::size_t id, const T &value) {
+    if (!contains(id))
+      throw std::invalid_argument("id is not in the heap");
+    const bool up = cmp(keys[id], value);
+    keys[id] = value;
+    if (up)
+      siftUp(position[id]);
+    else
+      siftDown(position[id]);
+  }
+
+private:
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  void moveTo(std::size_t id, std::size_t slot) {
+    heap[slot] = id;
+    position[id] = slot;
+  }
+
+  void siftUp(std::size_t i) {
+    std::size_t id = heap[i];
+    while (i > 0) {
+      std::size_t parent = (i - 1) / D;
+      if (!cmp(keys[heap[parent]], keys[id]))
+        break;
+      moveTo(heap[parent], i);
+      i = parent;
+    }
+    moveTo(id, i);
+  }
+
+  void siftDown(std::size_t i) {
+    const std::size_t n = heap.size();
+    std::size_t id = heap[i];
+    while (true) {
+      std::size_t first = D * i + 1;
+      if (first >= n)
+        break;
+      std::size_t last = std::min(first + D, n);
+      std::size_t best = first;
+      for (std::size_t c = first + 1; c < last; ++c) {
+        if (cmp(keys[heap[best]], keys[heap[c]]))
+          best = c;
+      }
+      if (!cmp(keys[id], keys[heap[best]]))
+        break;
+      moveTo(heap[best], i);
+      i = best;
+    }
+    moveTo(id, i);
+  }
+
+  std::vector<T> keys;
+  std::vector<std::size_t> position;
+  std::vector<std::size_t> heap;
+  Compare cmp;
+};
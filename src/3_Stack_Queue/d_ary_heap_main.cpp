@@ -0,0 +1,172 @@
+#include "d_ary_heap.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+struct TestRunner {
+  int total = 0;
+  int failed = 0;
+
+  void expectTrue(bool condition, const std::string &label) {
+    ++total;
+    if (condition) {
+      std::cout << "[PASS] " << label << "\n";
+      return;
+    }
+    ++failed;
+    std::cout << "[FAIL] " << label << "\n";
+  }
+
+  void summary() const {
+    std::cout << "Tests: " << total - failed << " passed, " << failed
+              << " failed, " << total << " total\n";
+  }
+};
+
+std::vector<int> randomValues(size_t n, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  std::vector<int> values(n);
+  for (auto &v : values)
+    v = dist(rng);
+  return values;
+}
+
+template <typename Heap> std::vector<int> drain(Heap &heap) {
+  std::vector<int> out;
+  while (!heap.empty()) {
+    out.push_back(heap.top());
+    heap.pop();
+  }
+  return out;
+}
+
+template <size_t D> void testOrdering(TestRunner &runner) {
+  const std::string suffix = " D=" + std::to_string(D);
+  std::vector<int> values = randomValues(1000, D);
+  std::vector<int> descending = values;
+  std::sort(descending.begin(), descending.end(), std::greater<int>());
+
+  DAryHeap<int, D> pushed;
+  pushed.reserve(values.size());
+  for (int v : values)
+    pushed.push(v);
+  runner.expectTrue(drain(pushed) == descending, "push/pop order" + suffix);
+
+  DAryHeap<int, D> bulk(values.begin(), values.end());
+  runner.expectTrue(bulk.size() == values.size(), "bulk size" + suffix);
+  runner.expectTrue(drain(bulk) == descending, "bulk heapify order" + suffix);
+
+  // replace_top keeps the 10 smallest values in a max-heap.
+  DAryHeap<int, D> bounded(values.begin(), values.begin() + 10);
+  for (size_t i = 10; i < values.size(); ++i) {
+    if (values[i] < bounded.top())
+      bounded.replace_top(values[i]);
+  }
+  std::vector<int> smallest(descending.end() - 10, descending.end());
+  runner.expectTrue(drain(bounded) == smallest, "replace_top top-k" + suffix);
+}
+
+// Dijkstra on a small graph exercises decreaseKey on a min-heap.
+void testIndexedHeap(TestRunner &runner) {
+  struct Edge {
+    size_t to;
+    int weight;
+  };
+  std::vector<std::vector<Edge>> graph = {
+      {{1, 4}, {2, 1}}, {{3, 1}}, {{1, 2}, {3, 5}}, {{4, 3}}, {}};
+  const int inf = std::numeric_limits<int>::max();
+  std::vector<int> dist(graph.size(), inf);
+  IndexedDAryHeap<int, 4, std::greater<int>> frontier(graph.size());
+  dist[0] = 0;
+  frontier.push(0, 0);
+  while (!frontier.empty()) {
+    size_t u = frontier.topId();
+    frontier.pop();
+    for (const Edge &e : graph[u]) {
+      int candidate = dist[u] + e.weight;
+      if (candidate < dist[e.to]) {
+        bool queued = frontier.contains(e.to);
+        dist[e.to] = candidate;
+        if (queued)
+          frontier.decreaseKey(e.to, candidate);
+        else
+          frontier.push(e.to, candidate);
+      }
+    }
+  }
+  runner.expectTrue(dist == std::vector<int>{0, 3, 1, 4, 7},
+                    "indexed decreaseKey dijkstra");
+
+  IndexedDAryHeap<int> maxHeap(4);
+  maxHeap.push(0, 10);
+  maxHeap.push(1, 20);
+  maxHeap.push(2, 30);
+  maxHeap.updateKey(2, 5);
+  runner.expectTrue(maxHeap.topId() == 1, "indexed updateKey down");
+  maxHeap.updateKey(0, 50);
+  runner.expectTrue(maxHeap.topId() == 0 && maxHeap.top() == 50,
+                    "indexed updateKey up");
+  bool threw = false;
+  try {
+    maxHeap.decreaseKey(0, 1);
+  } catch (const std::invalid_argument &) {
+    threw = true;
+  }
+  runner.expectTrue(threw, "indexed decreaseKey rejects wrong direction");
+}
+} // namespace
+
+void test() {
+  TestRunner runner;
+  testOrdering<2>(runner);
+  testOrdering<4>(runner);
+  testOrdering<8>(runner);
+  testIndexedHeap(runner);
+  runner.summary();
+}
+
+// Push n values, then pop them all, for std::priority_queue and DAryHeap.
+void benchmarkHeaps(size_t n) {
+  std::vector<int> values = randomValues(n, 2024);
+
+  auto nsPerOp = [&](auto &&heap) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int v : values)
+      heap.push(v);
+    long long checksum = 0;
+    while (!heap.empty()) {
+      checksum += heap.top();
+      heap.pop();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    volatile long long sink = checksum;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() /
+           static_cast<double>(2 * n);
+  };
+
+  std::cout << "\nHeap push+pop, n=" << n << " (ns/op)\n" << std::fixed
+            << std::setprecision(1);
+  std::cout << "  std::priority_queue " << nsPerOp(std::priority_queue<int>())
+            << "\n";
+  std::cout << "  DAryHeap<2>         " << nsPerOp(DAryHeap<int, 2>()) << "\n";
+  std::cout << "  DAryHeap<4>         " << nsPerOp(DAryHeap<int, 4>()) << "\n";
+  std::cout << "  DAryHeap<8>         " << nsPerOp(DAryHeap<int, 8>()) << "\n";
+}
+
+int main() {
+  test();
+  benchmarkHeaps(500000);
+  return 0;
+}
@@ -25,13 +25,28 @@
  * the four smallest numbers in sorted order.
  */
 
+#include "d_ary_heap.h"
+
 #include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <queue>
+#include <random>
+#include <span>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TOPK_HAS_X86 1
+#else
+#define TOPK_HAS_X86 0
+#endif
+
 #include <algorithm>
 #include <queue>
 #include <vector>
@@ -85,6 +100,36 @@ std::vector<int> findSmallestKNumbersHeap(const std::vector<int> &input,
   return result;
 }
 
+// 2b) D-ary Max Heap (size k)
+// Same as (2) on the 4-ary DAryHeap: the first k values are heapified in
+// O(k), and every smaller value replaces the top with a single sift-down
+// instead of pop + push.
+// Time:  O(n log k)
+// Space: O(k)
+std::vector<int> findSmallestKNumbersDAryHeap(const std::vector<int> &input,
+                                              int k) {
+  if (k <= 0)
+    return {};
+  if (k >= static_cast<int>(input.size())) {
+    std::vector<int> result = input;
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  DAryHeap<int, 4> maxHeap(input.begin(), input.begin() + k);
+  for (auto it = input.begin() + k; it != input.end(); ++it) {
+    if (*it < maxHeap.top())
+      maxHeap.replace_top(*it);
+  }
+
+  std::vector<int> result(k);
+  for (int i = k - 1; i >= 0; --i) {
+    result[i] = maxHeap.top();
+    maxHeap.pop();
+  }
+  return result;
+}
+
 // 3) nth_element
 // Avg Time: O(n), Worst: O(n^2)
 // Space:    O(n)
@@ -105,6 +150,166 @@ std::vector<int> findSmallestKNumbersNthElement(const std::vector<int> &input,
   return result;
 }
 
+// 4) Top-k Engine
+//
+// The routines above copy the input and run on one thread. The engine below
+// is built around BoundedMaxHeap, a max-heap that never holds more than k
+// values; its top is the current kth-smallest value (the threshold). Three
+// drivers share it:
+//   - findSmallestKNumbersParallel: one heap per thread over a contiguous
+//     slice, merged at the end. Time O((n / T) log k + T k log k).
+//   - findSmallestKNumbersStream: pulls values from any input iterator
+//     (e.g. std::istream_iterator over a file) in fixed-size chunks, so
+//     memory is O(k + chunk) no matter how long the stream is.
+//   - findSmallestKNumbersFiltered: once the heap is full, most values are
+//     above the threshold. An AVX2 compare + movemask rejects 8 values at a
+//     time without touching the heap (runtime-dispatched, scalar fallback).
+class BoundedMaxHeap {
+public:
+  explicit BoundedMaxHeap(size_t k) : k(k) { heap.reserve(k); }
+
+  bool full() const { return heap.size() == k; }
+
+  // Only meaningful once full(): values >= threshold() cannot be in the
+  // answer.
+  int threshold() const { return heap.front(); }
+
+  void push(int value) {
+    if (heap.size() < k) {
+      heap.push_back(value);
+      std::push_heap(heap.begin(), heap.end());
+    } else if (k > 0 && value < heap.front()) {
+      std::pop_heap(heap.begin(), heap.end());
+      heap.back() = value;
+      std::push_heap(heap.begin(), heap.end());
+    }
+  }
+
+  void pushBlock(std::span<const int> values) {
+    size_t i = 0;
+    for (; i < values.size() && !full(); ++i)
+      push(values[i]);
+    if (k == 0 || i == values.size())
+      return;
+#if TOPK_HAS_X86
+    if (cpuHasAvx2()) {
+      pushFilteredAvx2(values.subspan(i));
+      return;
+    }
+#endif
+    for (; i < values.size(); ++i) {
+      if (values[i] < heap.front())
+        push(values[i]);
+    }
+  }
+
+  void merge(const BoundedMaxHeap &other) {
+    for (int value : other.heap)
+      push(value);
+  }
+
+  std::vector<int> sorted() const {
+    std::vector<int> result = heap;
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+private:
+#if TOPK_HAS_X86
+  static bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+  }
+
+  __attribute__((target("avx2"))) void
+  pushFilteredAvx2(std::span<const int> values) {
+    const int *data = values.data();
+    const size_t n = values.size();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      __m256i block =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+      __m256i limit = _mm256_set1_epi32(heap.front());
+      // Lanes where value < threshold.
+      unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(
+          _mm256_castsi256_ps(_mm256_cmpgt_epi32(limit, block))));
+      while (mask) {
+        unsigned lane = static_cast<unsigned>(__builtin_ctz(mask));
+        push(data[i + lane]);
+        mask &= mask - 1;
+      }
+    }
+    for (; i < n; ++i) {
+      if (data[i] < heap.front())
+        push(data[i]);
+    }
+  }
+#endif
+
+  size_t k;
+  std::vector<int> heap;
+};
+
+std::vector<int> findSmallestKNumbersParallel(const std::vector<int> &input,
+                                              int k, unsigned threads = 0) {
+  if (k <= 0)
+    return {};
+  if (k >= static_cast<int>(input.size()))
+    return findSmallestKNumbersSort(input, k);
+
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  const size_t chunk = (input.size() + threads - 1) / threads;
+  std::vector<BoundedMaxHeap> heaps(threads, BoundedMaxHeap(k));
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    const size_t begin = std::min(input.size(), t * chunk);
+    const size_t end = std::min(input.size(), begin + chunk);
+    workers.emplace_back([&, t, begin, end] {
+      heaps[t].pushBlock(std::span<const int>(input.data() + begin,
+                                              end - begin));
+    });
+  }
+  for (auto &worker : workers)
+    worker.join();
+
+  for (unsigned t = 1; t < threads; ++t)
+    heaps[0].merge(heaps[t]);
+  return heaps[0].sorted();
+}
+
+template <typename InputIt>
+std::vector<int> findSmallestKNumbersStream(InputIt first, InputIt last, int k,
+                                            size_t chunkSize = 4096) {
+  if (k <= 0)
+    return {};
+
+  BoundedMaxHeap heap(k);
+  std::vector<int> chunk;
+  chunk.reserve(chunkSize);
+  while (first != last) {
+    chunk.clear();
+    while (first != last && chunk.size() < chunkSize) {
+      chunk.push_back(*first);
+      ++first;
+    }
+    heap.pushBlock(chunk);
+  }
+  return heap.sorted();
+}
+
+std::vector<int> findSmallestKNumbersFiltered(const std::vector<int> &input,
+                                              int k) {
+  if (k <= 0)
+    return {};
+  if (k >= static_cast<int>(input.size()))
+    return findSmallestKNumbersSort(input, k);
+
+  BoundedMaxHeap heap(k);
+  heap.pushBlock(input);
+  return heap.sorted();
+}
+
 namespace {
 struct TestRunner {
   int total = 0;
@@ -156,6 +361,9 @@ void testFindSmallestKNumbers() {
   // Test nth_element Method
   runner.expectEqual(findSmallestKNumbersNthElement(testArray1, 4), expected1,
                      "nth_element k=4");
+  // Test D-ary Heap Method
+  runner.expectEqual(findSmallestKNumbersDAryHeap(testArray1, 4), expected1,
+                     "d-ary heap k=4");
 
   std::vector<int> testArray2{4, 5, 1, 6, 2, 7, 3, 8};
   std::vector<int> expected2{1, 2, 3, 4, 5, 6, 7, 8};
@@ -165,6 +373,8 @@ void testFindSmallestKNumbers() {
                      "heap k=8");
   runner.expectEqual(findSmallestKNumbersNthElement(testArray2, 8), expected2,
                      "nth_element k=8");
+  runner.expectEqual(findSmallestKNumbersDAryHeap(testArray2, 8), expected2,
+                     "d-ary heap k=8");
 
   std::vector<int> testArray3{4, 5, 1, 6, 2, 7, 3, 8};
   std::vector<int> expected3{1};
@@ -183,10 +393,98 @@ void testFindSmallestKNumbers() {
                      "heap k=2 with dup");
   runner.expectEqual(findSmallestKNumbersNthElement(testArray4, 2), expected4,
                      "nth_element k=2 with dup");
+  runner.expectEqual(findSmallestKNumbersDAryHeap(testArray4, 2), expected4,
+                     "d-ary heap k=2 with dup");
+
+  // Top-k engine on the small examples
+  runner.expectEqual(findSmallestKNumbersParallel(testArray1, 4, 3), expected1,
+                     "parallel k=4");
+  runner.expectEqual(findSmallestKNumbersFiltered(testArray1, 4), expected1,
+                     "filtered k=4");
+  runner.expectEqual(findSmallestKNumbersParallel(testArray2, 8), expected2,
+                     "parallel k=8");
+  runner.expectEqual(findSmallestKNumbersFiltered(testArray4, 2), expected4,
+                     "filtered k=2 with dup");
+  runner.expectEqual(findSmallestKNumbersFiltered(testArray1, 0), {},
+                     "filtered k=0");
+  {
+    std::istringstream file("4 5 1 6 2 7 3 8");
+    runner.expectEqual(
+        findSmallestKNumbersStream(std::istream_iterator<int>(file),
+                                   std::istream_iterator<int>(), 4, 3),
+        expected1, "stream k=4 chunk=3");
+  }
+
+  // Top-k engine against nth_element on random data
+  {
+    std::mt19937 rng(31337);
+    std::uniform_int_distribution<int> dist(-100000, 100000);
+    std::vector<int> input(50000);
+    for (auto &v : input)
+      v = dist(rng);
+    for (int k : {1, 7, 100, 1000, 49999}) {
+      std::vector<int> expected = findSmallestKNumbersNthElement(input, k);
+      std::string suffix = " random k=" + std::to_string(k);
+      runner.expectEqual(findSmallestKNumbersParallel(input, k, 4), expected,
+                         "parallel" + suffix);
+      runner.expectEqual(findSmallestKNumbersFiltered(input, k), expected,
+                         "filtered" + suffix);
+      runner.expectEqual(findSmallestKNumbersDAryHeap(input, k), expected,
+                         "d-ary heap" + suffix);
+      runner.expectEqual(
+          findSmallestKNumbersStream(input.begin(), input.end(), k, 1000),
+          expected, "stream" + suffix);
+    }
+  }
   runner.summary();
 }
 
+// Throughput of the top-k drivers. Pass a larger n (e.g. 10^9) and k up to
+// 10^6 for production-scale numbers.
+void benchmarkTopK(size_t n, const std::vector<int> &ks) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> dist;
+  std::vector<int> input(n);
+  for (auto &v : input)
+    v = dist(rng);
+
+  auto rate = [&](auto &&fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    auto result = fn();
+    auto t1 = std::chrono::steady_clock::now();
+    volatile size_t sink = result.size();
+    (void)sink;
+    return static_cast<double>(n) /
+           std::chrono::duration<double>(t1 - t0).count() / 1e6;
+  };
+
+  std::cout << "\nTop-k throughput, n=" << n << " (Melem/s)\n";
+  std::cout << std::left << std::setw(10) << "k" << std::setw(12) << "heap"
+            << std::setw(12) << "d-ary" << std::setw(12) << "nth"
+            << std::setw(12) << "filtered" << std::setw(12) << "parallel"
+            << std::setw(12) << "stream" << "\n";
+  for (int k : ks) {
+    std::cout << std::left << std::fixed << std::setprecision(1)
+              << std::setw(10) << k << std::setw(12)
+              << rate([&] { return findSmallestKNumbersHeap(input, k); })
+              << std::setw(12)
+              << rate([&] { return findSmallestKNumbersDAryHeap(input, k); })
+              << std::setw(12)
+              << rate([&] { return findSmallestKNumbersNthElement(input, k); })
+              << std::setw(12)
+              << rate([&] { return findSmallestKNumbersFiltered(input, k); })
+              << std::setw(12)
+              << rate([&] { return findSmallestKNumbersParallel(input, k); })
+              << std::setw(12) << rate([&] {
+                   return findSmallestKNumbersStream(input.begin(),
+                                                     input.end(), k);
+                 })
+              << "\n";
+  }
+}
+
 int main() {
   testFindSmallestKNumbers();
+  benchmarkTopK(2000000, {1, 100, 10000});
   return 0;
 }
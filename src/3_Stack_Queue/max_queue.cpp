@@ -28,13 +28,21 @@
  *     - After a pop operation (removing 3), the maximum remains 5.
  */
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <chrono>
 #include <deque>
+#include <functional>
+#include <iomanip>
 #include <iostream>
 #include <limits>
 #include <optional>
 #include <queue>
+#include <random>
 #include <set>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -136,6 +144,110 @@ private:
   std::multiset<int> mset;
 };
 
+// Batch Kernels (Array In, Array Out)
+//
+// The queue classes above work one element at a time. When the whole signal
+// is already in memory it is cheaper to compute the maximum of every window
+// in one call: the kernels below write the n - w + 1 window results into a
+// caller-provided output span. Passing std::greater<int> as the comparator
+// turns either kernel into a sliding-window minimum.
+
+// Monotonic ring-buffer kernel.
+// Same idea as OptimalMaxQueue, but candidate indices live in a fixed ring of
+// power-of-two capacity >= w that is allocated once per call, so there is no
+// allocation or deque bookkeeping per element.
+// Time: O(n), Space: O(w).
+template <typename Compare = std::less<int>>
+void slidingWindowRing(std::span<const int> input, size_t window,
+                       std::span<int> output, Compare cmp = Compare{}) {
+  if (window == 0 || window > input.size())
+    throw std::invalid_argument("Window must be in [1, input size].");
+  if (output.size() < input.size() - window + 1)
+    throw std::invalid_argument("Output span is too small.");
+
+  const size_t capacity = std::bit_ceil(window);
+  const size_t mask = capacity - 1;
+  std::vector<size_t> ring(capacity);
+  size_t head = 0; // live candidates are ring[head .. tail)
+  size_t tail = 0;
+
+  for (size_t i = 0; i < input.size(); ++i) {
+    // At most one index leaves the window per step.
+    if (head != tail && ring[head & mask] + window <= i)
+      ++head;
+
+    const int x = input[i];
+    while (head != tail && cmp(input[ring[(tail - 1) & mask]], x))
+      --tail;
+    ring[tail++ & mask] = i;
+
+    if (i + 1 >= window)
+      output[i + 1 - window] = input[ring[head & mask]];
+  }
+}
+
+// van Herk / Gil-Werman block kernel.
+// Splits the input into blocks of size w and records a running prefix and
+// suffix extreme inside every block. Any window spans at most two blocks, so
+// its answer is best(suffix[i], prefix[i + w - 1]). Exactly three streaming
+// passes regardless of w; the combine pass is branch-free and is
+// auto-vectorized by the compiler.
+// Time: O(n), Space: O(n).
+template <typename Compare = std::less<int>>
+void slidingWindowBlocked(std::span<const int> input, size_t window,
+                          std::span<int> output, Compare cmp = Compare{}) {
+  if (window == 0 || window > input.size())
+    throw std::invalid_argument("Window must be in [1, input size].");
+  if (output.size() < input.size() - window + 1)
+    throw std::invalid_argument("Output span is too small.");
+
+  const size_t n = input.size();
+  auto best = [&cmp](int a, int b) { return cmp(a, b) ? b : a; };
+  std::vector<int> prefix(n);
+  std::vector<int> suffix(n);
+
+  for (size_t start = 0; start < n; start += window) {
+    const size_t end = std::min(start + window, n);
+
+    int run = input[start];
+    prefix[start] = run;
+    for (size_t i = start + 1; i < end; ++i) {
+      run = best(run, input[i]);
+      prefix[i] = run;
+    }
+
+    run = input[end - 1];
+    suffix[end - 1] = run;
+    for (size_t i = end - 1; i-- > start;) {
+      run = best(run, input[i]);
+      suffix[i] = run;
+    }
+  }
+
+  const size_t count = n - window + 1;
+  for (size_t i = 0; i < count; ++i) {
+    output[i] = best(suffix[i], prefix[i + window - 1]);
+  }
+}
+
+// Convenience wrappers returning a freshly allocated result.
+std::vector<int> slidingWindowMaxRing(const std::vector<int> &input,
+                                      size_t window) {
+  std::vector<int> result(input.size() >= window ? input.size() - window + 1
+                                                 : 0);
+  slidingWindowRing(std::span<const int>(input), window, std::span<int>(result));
+  return result;
+}
+
+std::vector<int> slidingWindowMaxBlocked(const std::vector<int> &input,
+                                         size_t window) {
+  std::vector<int> result(input.size() >= window ? input.size() - window + 1
+                                                 : 0);
+  slidingWindowBlocked(std::span<const int>(input), window,
+                       std::span<int>(result));
+  return result;
+}
+
 namespace {
 struct TestRunner {
   int total = 0;
@@ -152,11 +264,44 @@ struct TestRunner {
               << " got=" << got << "\n";
   }
 
+  void expectTrue(bool condition, const std::string &label) {
+    ++total;
+    if (condition) {
+      std::cout << "[PASS] " << label << "\n";
+      return;
+    }
+    ++failed;
+    std::cout << "[FAIL] " << label << "\n";
+  }
+
   void summary() const {
     std::cout << "Tests: " << total - failed << " passed, " << failed
               << " failed, " << total << " total\n";
   }
 };
+
+// Reference answer built on top of OptimalMaxQueue.
+std::vector<int> queueWindowMax(const std::vector<int> &input, size_t window) {
+  std::vector<int> result;
+  OptimalMaxQueue mq;
+  for (size_t i = 0; i < input.size(); ++i) {
+    mq.push(input[i]);
+    if (i >= window)
+      mq.pop();
+    if (i + 1 >= window)
+      result.push_back(mq.max());
+  }
+  return result;
+}
+
+std::vector<int> makeRandomSignal(size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  std::vector<int> values(n);
+  for (auto &v : values)
+    v = dist(rng);
+  return values;
+}
 } // namespace
 
 // Test cases for correctness
@@ -207,10 +352,127 @@ void test() {
                        "AlternativeMaxQueue max #2");
   }
 
+  // Batch kernels on a known example
+  {
+    std::vector<int> input = {1, 3, -1, -3, 5, 3, 6, 7};
+    std::vector<int> expected = {3, 3, 5, 5, 6, 7};
+    runner.expectTrue(slidingWindowMaxRing(input, 3) == expected,
+                      "slidingWindowMaxRing w=3");
+    runner.expectTrue(slidingWindowMaxBlocked(input, 3) == expected,
+                      "slidingWindowMaxBlocked w=3");
+    runner.expectTrue(slidingWindowMaxRing(input, 1) == input,
+                      "slidingWindowMaxRing w=1");
+    runner.expectTrue(slidingWindowMaxBlocked(input, 8) ==
+                          std::vector<int>{7},
+                      "slidingWindowMaxBlocked w=n");
+  }
+
+  // Batch kernels against the queue on random signals
+  {
+    std::vector<int> input = makeRandomSignal(5000, 42);
+    for (size_t window : {2u, 3u, 7u, 64u, 100u, 999u, 4096u, 5000u}) {
+      std::vector<int> expected = queueWindowMax(input, window);
+      runner.expectTrue(slidingWindowMaxRing(input, window) == expected,
+                        "ring vs queue w=" + std::to_string(window));
+      runner.expectTrue(slidingWindowMaxBlocked(input, window) == expected,
+                        "blocked vs queue w=" + std::to_string(window));
+    }
+  }
+
+  // Sliding-window minimum through the comparator
+  {
+    std::vector<int> input = makeRandomSignal(2000, 7);
+    std::vector<int> negated(input.size());
+    std::transform(input.begin(), input.end(), negated.begin(),
+                   [](int v) { return -v; });
+    const size_t window = 37;
+    std::vector<int> expected = queueWindowMax(negated, window);
+    std::transform(expected.begin(), expected.end(), expected.begin(),
+                   [](int v) { return -v; });
+
+    std::vector<int> ringMin(input.size() - window + 1);
+    std::vector<int> blockedMin(input.size() - window + 1);
+    slidingWindowRing(std::span<const int>(input), window,
+                      std::span<int>(ringMin), std::greater<int>{});
+    slidingWindowBlocked(std::span<const int>(input), window,
+                         std::span<int>(blockedMin), std::greater<int>{});
+    runner.expectTrue(ringMin == expected, "ring sliding-window min");
+    runner.expectTrue(blockedMin == expected, "blocked sliding-window min");
+  }
+
+  // Invalid window sizes are rejected
+  {
+    std::vector<int> input = {1, 2, 3};
+    bool threwZero = false;
+    bool threwLarge = false;
+    try {
+      slidingWindowMaxRing(input, 0);
+    } catch (const std::invalid_argument &) {
+      threwZero = true;
+    }
+    try {
+      slidingWindowMaxBlocked(input, 4);
+    } catch (const std::invalid_argument &) {
+      threwLarge = true;
+    }
+    runner.expectTrue(threwZero, "window 0 throws");
+    runner.expectTrue(threwLarge, "window > n throws");
+  }
+
   runner.summary();
 }
 
+// Throughput of the batch kernels (and the element-wise queue for scale)
+// across window sizes. Pass a larger n for production-sized signals.
+void benchmarkSlidingWindow(size_t n) {
+  std::vector<int> input = makeRandomSignal(n, 2024);
+  std::vector<int> output(n);
+
+  auto measure = [&](auto &&fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    auto t1 = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    return static_cast<double>(n) / seconds / 1e6;
+  };
+
+  std::cout << "\nSliding-window max throughput, n=" << n
+            << " (Melem/s)\n";
+  std::cout << std::left << std::setw(10) << "window" << std::setw(12)
+            << "queue" << std::setw(12) << "ring" << std::setw(12)
+            << "blocked" << "\n";
+
+  for (size_t window : {3u, 10u, 100u, 1000u, 10000u, 100000u}) {
+    if (window > n)
+      break;
+    const size_t count = n - window + 1;
+    double queueRate = measure([&] {
+      OptimalMaxQueue mq;
+      for (size_t i = 0; i < n; ++i) {
+        mq.push(input[i]);
+        if (i >= window)
+          mq.pop();
+        if (i + 1 >= window)
+          output[i + 1 - window] = mq.max();
+      }
+    });
+    double ringRate = measure([&] {
+      slidingWindowRing(std::span<const int>(input), window,
+                        std::span<int>(output.data(), count));
+    });
+    double blockedRate = measure([&] {
+      slidingWindowBlocked(std::span<const int>(input), window,
+                           std::span<int>(output.data(), count));
+    });
+    std::cout << std::left << std::fixed << std::setprecision(1)
+              << std::setw(10) << window << std::setw(12) << queueRate
+              << std::setw(12) << ringRate << std::setw(12) << blockedRate
+              << "\n";
+  }
+}
+
 int main() {
   test();
+  benchmarkSlidingWindow(1000000);
   return 0;
 }
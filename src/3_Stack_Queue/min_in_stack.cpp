@@ -33,11 +33,18 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
 #include <optional>
+#include <random>
 #include <stack>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 // Template class for a stack that tracks the minimum element in O(1) time.
 template <typename T> class StackWithMin {
@@ -87,6 +94,101 @@ private:
   std::optional<T> _min;
 };
 
+// Fixed-capacity, contiguous variant for hot paths.
+//
+// Values and running minima live in two parallel arrays (structure of
+// arrays): mins[i] is the minimum of values[0..i]. Nothing is allocated per
+// push and no encoding is needed, so any T with operator< works and there is
+// no 2 * value - min overflow.
+//
+// - Capacity > 0: storage is two std::array members sized at compile time
+//   (T must be default-constructible).
+// - Capacity == 0: two vectors reserve `capacity` slots once in the
+//   constructor; elements are only constructed when pushed and destroyed
+//   when popped, so T needs no default constructor.
+// push() throws std::overflow_error when full. The checked top()/min() keep
+// the std::optional interface of StackWithMin; topUnchecked() and
+// minUnchecked() return by reference for callers that already checked
+// empty().
+template <typename T, size_t Capacity = 0> class ContiguousStackWithMin {
+  static constexpr bool kReserved = Capacity == 0;
+  using Storage = std::conditional_t<kReserved, std::vector<T>,
+                                     std::array<T, Capacity>>;
+
+public:
+  ContiguousStackWithMin()
+    requires(Capacity > 0)
+  = default;
+
+  explicit ContiguousStackWithMin(size_t capacity)
+    requires(Capacity == 0)
+      : limit(capacity) {
+    values.reserve(capacity);
+    mins.reserve(capacity);
+  }
+
+  void push(const T &value) {
+    const size_t count = size();
+    if (count == capacity())
+      throw std::overflow_error("StackWithMin capacity exceeded");
+    const T &min =
+        (count == 0 || value < mins[count - 1]) ? value : mins[count - 1];
+    if constexpr (kReserved) {
+      mins.push_back(min);
+      values.push_back(value);
+    } else {
+      mins[count] = min;
+      values[count] = value;
+      ++used;
+    }
+  }
+
+  void pop() {
+    if (empty())
+      return;
+    if constexpr (kReserved) {
+      values.pop_back();
+      mins.pop_back();
+    } else {
+      --used;
+    }
+  }
+
+  std::optional<T> top() const {
+    return empty() ? std::nullopt : std::optional<T>(topUnchecked());
+  }
+
+  std::optional<T> min() const {
+    return empty() ? std::nullopt : std::optional<T>(minUnchecked());
+  }
+
+  const T &topUnchecked() const { return values[size() - 1]; }
+  const T &minUnchecked() const { return mins[size() - 1]; }
+
+  bool empty() const { return size() == 0; }
+  size_t size() const {
+    if constexpr (kReserved)
+      return values.size();
+    else
+      return used;
+  }
+  size_t capacity() const { return kReserved ? limit : Capacity; }
+  void clear() {
+    if constexpr (kReserved) {
+      values.clear();
+      mins.clear();
+    } else {
+      used = 0;
+    }
+  }
+
+private:
+  Storage values{};
+  Storage mins{};
+  size_t used = 0;  // Capacity > 0 only
+  size_t limit = 0; // Capacity == 0 only
+};
+
 namespace {
 struct TestRunner {
   int total = 0;
@@ -105,6 +207,16 @@ struct TestRunner {
               << " got=" << toString(got) << "\n";
   }
 
+  void expectTrue(bool condition, const std::string &label) {
+    ++total;
+    if (condition) {
+      std::cout << "[PASS] " << label << "\n";
+      return;
+    }
+    ++failed;
+    std::cout << "[FAIL] " << label << "\n";
+  }
+
   void summary() const {
     std::cout << "Tests: " << total - failed << " passed, " << failed
               << " failed, " << total << " total\n";
@@ -335,10 +447,135 @@ void test() {
                        "top empty at end of long sequence");
   }
 
+  // 9) Contiguous variants follow the same example
+  {
+    ContiguousStackWithMin<int, 8> fixed;
+    ContiguousStackWithMin<int> reserved(8);
+    runner.expectEqual(fixed.min(), std::optional<int>{},
+                       "contiguous min on empty");
+    fixed.pop();
+    runner.expectEqual(fixed.top(), std::optional<int>{},
+                       "contiguous top after pop on empty");
+    for (int v : {10, 5, 2}) {
+      fixed.push(v);
+      reserved.push(v);
+    }
+    runner.expectEqual(fixed.min(), std::optional<int>(2),
+                       "contiguous fixed min after push");
+    runner.expectEqual(std::optional<int>(reserved.topUnchecked()),
+                       std::optional<int>(2),
+                       "contiguous reserved unchecked top");
+    fixed.pop();
+    reserved.pop();
+    runner.expectEqual(fixed.min(), std::optional<int>(5),
+                       "contiguous fixed min after pop");
+    runner.expectEqual(std::optional<int>(reserved.minUnchecked()),
+                       std::optional<int>(5),
+                       "contiguous reserved unchecked min after pop");
+
+    ContiguousStackWithMin<int, 2> tiny;
+    tiny.push(1);
+    tiny.push(2);
+    bool overflowed = false;
+    try {
+      tiny.push(3);
+    } catch (const std::overflow_error &) {
+      overflowed = true;
+    }
+    runner.expectTrue(overflowed, "contiguous push past capacity throws");
+
+    // The reserved variant only constructs pushed elements.
+    struct Money {
+      explicit Money(long cents) : cents(cents) {}
+      bool operator<(const Money &other) const { return cents < other.cents; }
+      long cents;
+    };
+    ContiguousStackWithMin<Money> wallet(3);
+    for (long cents : {300, 120, 450})
+      wallet.push(Money(cents));
+    wallet.pop();
+    runner.expectTrue(wallet.size() == 2 && wallet.capacity() == 3 &&
+                          wallet.minUnchecked().cents == 120,
+                      "contiguous reserved non-default-constructible T");
+  }
+
+  // 10) Random operations: contiguous variant matches StackWithMin
+  {
+    std::mt19937 rng(4242);
+    std::uniform_int_distribution<int> value(-1000, 1000);
+    StackWithMin<int> reference;
+    ContiguousStackWithMin<int> contiguous(5000);
+    bool allMatch = true;
+    for (int step = 0; step < 5000; ++step) {
+      if (rng() % 3 != 0) {
+        int v = value(rng);
+        reference.push(v);
+        contiguous.push(v);
+      } else {
+        reference.pop();
+        contiguous.pop();
+      }
+      allMatch = allMatch && reference.min() == contiguous.min() &&
+                 reference.top() == contiguous.top();
+    }
+    runner.expectTrue(allMatch,
+                      "contiguous matches StackWithMin on random ops");
+  }
+
   runner.summary();
 }
 
+// Latency of a push, a min() read and a pop, in bursts of depth `depth`.
+template <typename Stack, typename ReadMin>
+double nsPerOperation(Stack &stack, const std::vector<int> &values,
+                      size_t depth, ReadMin readMin) {
+  long long checksum = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (size_t start = 0; start + depth <= values.size(); start += depth) {
+    for (size_t i = start; i < start + depth; ++i) {
+      stack.push(values[i]);
+      checksum += readMin(stack);
+    }
+    for (size_t i = 0; i < depth; ++i)
+      stack.pop();
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  volatile long long sink = checksum;
+  (void)sink;
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() /
+         static_cast<double>(3 * values.size());
+}
+
+void benchmarkStacks(size_t operations) {
+  constexpr size_t depth = 1024;
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> dist(-100000, 100000);
+  std::vector<int> values(operations);
+  for (auto &v : values)
+    v = dist(rng);
+
+  StackWithMin<int> original;
+  ContiguousStackWithMin<int, depth> fixed;
+  ContiguousStackWithMin<int> reserved(depth);
+
+  std::cout << "\npush/min/pop latency, depth " << depth << " (ns/op)\n"
+            << std::fixed << std::setprecision(2);
+  std::cout << "  StackWithMin (std::stack)      "
+            << nsPerOperation(original, values, depth,
+                              [](auto &s) { return *s.min(); })
+            << "\n";
+  std::cout << "  ContiguousStackWithMin<1024>   "
+            << nsPerOperation(fixed, values, depth,
+                              [](auto &s) { return s.minUnchecked(); })
+            << "\n";
+  std::cout << "  ContiguousStackWithMin(1024)   "
+            << nsPerOperation(reserved, values, depth,
+                              [](auto &s) { return s.minUnchecked(); })
+            << "\n";
+}
+
 int main() {
   test();
+  benchmarkStacks(1 << 20);
   return 0;
 }
@@ -26,9 +26,17 @@
  */
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <numeric>
+#include <random>
+#include <span>
 #include <stack>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 // Simulation Solution: Efficient O(n) approach.
@@ -116,6 +124,157 @@ bool isValidPopOrderRecursive(const std::vector<int> &push_order,
   return false;
 }
 
+// Batch Validator
+//
+// Validates many recorded pop orders against one shared push order.
+// - Each worker thread owns one scratch stack reserved to n up front and
+//   reuses it for every sequence, so validation does not allocate.
+// - Sequences are stored back to back in one contiguous buffer (stride n)
+//   and split into equal ranges across threads.
+// - When the push order is a permutation of 0..n-1 the validator keeps an
+//   inverse index (value -> push position). The stack then holds push
+//   positions: "push until the top matches" becomes a single jump of the
+//   push cursor, values outside 0..n-1 are rejected with one comparison, and
+//   a repeated value fails because its position is already behind the
+//   cursor and below the top.
+// Time: O(n) per sequence, Space: O(n) per thread.
+class PopOrderBatchValidator {
+public:
+  explicit PopOrderBatchValidator(std::vector<int> push_order)
+      : push_order(std::move(push_order)) {
+    const size_t n = this->push_order.size();
+    position.assign(n, n);
+    identityDomain = true;
+    for (size_t i = 0; i < n && identityDomain; ++i) {
+      int value = this->push_order[i];
+      if (value < 0 || static_cast<size_t>(value) >= n ||
+          position[value] != n) {
+        identityDomain = false;
+      } else {
+        position[value] = i;
+      }
+    }
+    if (!identityDomain)
+      position.clear();
+  }
+
+  size_t length() const { return push_order.size(); }
+
+  bool hasPermutationFastPath() const { return identityDomain; }
+
+  // Single sequence, using the calling thread's scratch stack.
+  bool isValid(std::span<const int> pop_order) const {
+    thread_local std::vector<size_t> scratch;
+    scratch.reserve(push_order.size());
+    return isValid(pop_order, scratch);
+  }
+
+  bool isValid(std::span<const int> pop_order,
+               std::vector<size_t> &scratch) const {
+    if (push_order.empty() || pop_order.size() != push_order.size())
+      return false;
+    scratch.clear();
+    return identityDomain ? validatePermutation(pop_order, scratch)
+                          : validateGeneral(pop_order, scratch);
+  }
+
+  // `pop_orders` holds sequences back to back; its size must be a multiple
+  // of length(). Returns one 0/1 flag per sequence.
+  std::vector<uint8_t> validateBatch(std::span<const int> pop_orders,
+                                     unsigned threads = 0) const {
+    const size_t n = push_order.size();
+    if (n == 0 || pop_orders.size() % n != 0)
+      throw std::invalid_argument("Batch size must be a multiple of n.");
+
+    const size_t count = pop_orders.size() / n;
+    std::vector<uint8_t> results(count, 0);
+    if (threads == 0)
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(
+        std::min<size_t>(threads, std::max<size_t>(count, 1)));
+
+    auto worker = [&](size_t begin, size_t end) {
+      std::vector<size_t> scratch;
+      scratch.reserve(n);
+      for (size_t i = begin; i < end; ++i)
+        results[i] = isValid(pop_orders.subspan(i * n, n), scratch);
+    };
+
+    const size_t chunk = (count + threads - 1) / threads;
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) {
+      const size_t begin = std::min(count, t * chunk);
+      pool.emplace_back(worker, begin, std::min(count, begin + chunk));
+    }
+    worker(0, std::min(count, chunk));
+    for (auto &thread : pool)
+      thread.join();
+    return results;
+  }
+
+  std::vector<uint8_t>
+  validateBatch(const std::vector<std::vector<int>> &pop_orders,
+                unsigned threads = 0) const {
+    const size_t n = push_order.size();
+    std::vector<int> flat;
+    flat.reserve(pop_orders.size() * n);
+    std::vector<uint8_t> wrongLength(pop_orders.size(), 0);
+    for (size_t i = 0; i < pop_orders.size(); ++i) {
+      if (pop_orders[i].size() == n) {
+        flat.insert(flat.end(), pop_orders[i].begin(), pop_orders[i].end());
+      } else {
+        wrongLength[i] = 1;
+        flat.insert(flat.end(), n, -1); // never valid
+      }
+    }
+    std::vector<uint8_t> results = validateBatch(flat, threads);
+    for (size_t i = 0; i < results.size(); ++i)
+      results[i] = results[i] && !wrongLength[i];
+    return results;
+  }
+
+private:
+  bool validateGeneral(std::span<const int> pop_order,
+                       std::vector<size_t> &stack) const {
+    size_t push_index = 0;
+    for (int pop_value : pop_order) {
+      while (stack.empty() || push_order[stack.back()] != pop_value) {
+        if (push_index == push_order.size())
+          return false;
+        stack.push_back(push_index++);
+      }
+      stack.pop_back();
+    }
+    return stack.empty();
+  }
+
+  bool validatePermutation(std::span<const int> pop_order,
+                           std::vector<size_t> &stack) const {
+    const size_t n = push_order.size();
+    size_t push_index = 0;
+    for (int pop_value : pop_order) {
+      if (pop_value < 0 || static_cast<size_t>(pop_value) >= n)
+        return false;
+      const size_t target = position[pop_value];
+      if (target >= push_index) {
+        // Push everything before target; target itself is popped at once.
+        for (size_t i = push_index; i < target; ++i)
+          stack.push_back(i);
+        push_index = target + 1;
+      } else if (!stack.empty() && stack.back() == target) {
+        stack.pop_back();
+      } else {
+        return false;
+      }
+    }
+    return stack.empty();
+  }
+
+  std::vector<int> push_order;
+  std::vector<size_t> position;
+  bool identityDomain = false;
+};
+
 namespace {
 struct TestRunner {
   int total = 0;
@@ -169,10 +328,130 @@ void test() {
   runner.expectEqual(isValidPopOrderRecursive(push_order, pop_order4), false,
                      "recursive invalid #2");
 
+  // Batch validator: general path (values are not 0..n-1).
+  PopOrderBatchValidator general(push_order);
+  runner.expectEqual(general.hasPermutationFastPath(), false,
+                     "batch general path selected");
+  std::vector<uint8_t> flags = general.validateBatch(
+      {pop_order1, pop_order2, pop_order3, pop_order4, {1, 2}}, 2);
+  runner.expectEqual(flags[0], true, "batch general valid #1");
+  runner.expectEqual(flags[1], true, "batch general valid #2");
+  runner.expectEqual(flags[2], false, "batch general invalid #1");
+  runner.expectEqual(flags[3], false, "batch general invalid #2");
+  runner.expectEqual(flags[4], false, "batch general wrong length");
+
+  // Batch validator: permutation fast path.
+  PopOrderBatchValidator fast({0, 1, 2, 3, 4});
+  runner.expectEqual(fast.hasPermutationFastPath(), true,
+                     "batch fast path selected");
+  runner.expectEqual(fast.isValid(std::vector<int>{3, 4, 2, 1, 0}), true,
+                     "fast path valid");
+  runner.expectEqual(fast.isValid(std::vector<int>{3, 2, 4, 0, 1}), false,
+                     "fast path invalid");
+  runner.expectEqual(fast.isValid(std::vector<int>{3, 3, 2, 1, 0}), false,
+                     "fast path repeated value");
+  runner.expectEqual(fast.isValid(std::vector<int>{3, 4, 2, 1, 7}), false,
+                     "fast path out of range");
+
+  // Random sequences: fast path, general path and simulation must agree.
+  {
+    const size_t n = 12;
+    std::mt19937 rng(99);
+    std::vector<int> shuffled(n);
+    std::iota(shuffled.begin(), shuffled.end(), 0);
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    std::vector<int> shifted = shuffled;
+    for (auto &v : shifted)
+      v += 100; // same shape, but forces the general path
+
+    PopOrderBatchValidator permutation(shuffled);
+    PopOrderBatchValidator offset(shifted);
+    std::vector<int> flatPerm;
+    std::vector<int> flatOffset;
+    std::vector<bool> expected;
+    for (int trial = 0; trial < 2000; ++trial) {
+      std::vector<int> candidate = shuffled;
+      if (trial % 2 == 0) {
+        // Produce a valid order by random push/pop simulation.
+        std::vector<int> stack;
+        candidate.clear();
+        size_t next = 0;
+        while (candidate.size() < n) {
+          if (next < n && (stack.empty() || rng() % 2)) {
+            stack.push_back(shuffled[next++]);
+          } else {
+            candidate.push_back(stack.back());
+            stack.pop_back();
+          }
+        }
+      } else {
+        std::shuffle(candidate.begin(), candidate.end(), rng);
+      }
+      std::vector<int> candidateOffset = candidate;
+      for (auto &v : candidateOffset)
+        v += 100;
+      flatPerm.insert(flatPerm.end(), candidate.begin(), candidate.end());
+      flatOffset.insert(flatOffset.end(), candidateOffset.begin(),
+                        candidateOffset.end());
+      expected.push_back(isValidPopOrderSimulation(shuffled, candidate));
+    }
+    std::vector<uint8_t> permFlags = permutation.validateBatch(flatPerm, 4);
+    std::vector<uint8_t> offsetFlags = offset.validateBatch(flatOffset, 3);
+    bool allMatch = true;
+    for (size_t i = 0; i < expected.size(); ++i) {
+      allMatch = allMatch && static_cast<bool>(permFlags[i]) == expected[i] &&
+                 static_cast<bool>(offsetFlags[i]) == expected[i];
+    }
+    runner.expectEqual(allMatch, true, "batch paths agree with simulation");
+  }
+
   runner.summary();
 }
 
+// Throughput of batch validation versus calling the simulation per sequence.
+void benchmarkBatchValidation(size_t n, size_t sequences) {
+  std::vector<int> push_order(n);
+  std::iota(push_order.begin(), push_order.end(), 0);
+  std::vector<int> reversed(push_order.rbegin(), push_order.rend());
+
+  std::vector<int> flat;
+  flat.reserve(n * sequences);
+  for (size_t i = 0; i < sequences; ++i)
+    flat.insert(flat.end(), reversed.begin(), reversed.end());
+
+  auto perSecond = [&](auto &&fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    size_t valid = fn();
+    auto t1 = std::chrono::steady_clock::now();
+    if (valid != sequences)
+      std::cout << "  unexpected result count " << valid << "\n";
+    return static_cast<double>(sequences) /
+           std::chrono::duration<double>(t1 - t0).count();
+  };
+
+  double simulation = perSecond([&] {
+    size_t valid = 0;
+    for (size_t i = 0; i < sequences; ++i) {
+      std::vector<int> pop(flat.begin() + i * n, flat.begin() + (i + 1) * n);
+      valid += isValidPopOrderSimulation(push_order, pop);
+    }
+    return valid;
+  });
+  PopOrderBatchValidator validator(push_order);
+  double batch = perSecond([&] {
+    auto flags = validator.validateBatch(flat);
+    return static_cast<size_t>(std::count(flags.begin(), flags.end(), 1));
+  });
+
+  std::cout << "\nPop order validation, n=" << n << ", " << sequences
+            << " sequences\n"
+            << "  simulation: " << static_cast<size_t>(simulation)
+            << " seq/s\n"
+            << "  batch:      " << static_cast<size_t>(batch) << " seq/s\n";
+}
+
 int main() {
   test();
+  benchmarkBatchValidation(64, 100000);
   return 0;
 }
@@ -36,15 +36,23 @@
  * or the average of the two middle numbers if the list has an even length.
  */
 
+#include "d_ary_heap.h"
+
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <exception>
 #include <iomanip>
 #include <iostream>
 #include <queue>
+#include <random>
 #include <set>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 // Simple (Brute-force) Solution
@@ -130,6 +138,64 @@ private:
   std::priority_queue<double> maxHeap;
 };
 
+// Optimal Solution on a D-ary Heap
+//
+// Same two-heap algorithm, but on the 4-ary DAryHeap from d_ary_heap.h
+// instead of std::priority_queue: the heaps are half as deep, children are
+// compared within one cache line, storage can be reserved up front, and
+// rebalancing moves an element with one replace_top() instead of pop + push.
+//
+// Time/Space Complexity: same as OptimalMedianCalculator.
+class DAryHeapMedianCalculator {
+public:
+  void reserve(size_t n) {
+    minHeap.reserve(n / 2 + 1);
+    maxHeap.reserve(n / 2 + 1);
+  }
+
+  void insert(double num) {
+    if (minHeap.empty() || num >= minHeap.top()) {
+      if (minHeap.size() == maxHeap.size() + 1) {
+        // minHeap would overflow: its smallest element moves down.
+        if (num > minHeap.top()) {
+          maxHeap.push(minHeap.top());
+          minHeap.replace_top(num);
+        } else {
+          maxHeap.push(num);
+        }
+      } else {
+        minHeap.push(num);
+      }
+    } else {
+      if (maxHeap.size() == minHeap.size()) {
+        // maxHeap would overflow: the larger of num and its top moves up.
+        if (num < maxHeap.top()) {
+          minHeap.push(maxHeap.top());
+          maxHeap.replace_top(num);
+        } else {
+          minHeap.push(num);
+        }
+      } else {
+        maxHeap.push(num);
+      }
+    }
+  }
+
+  double getMedian() const {
+    if (minHeap.empty() && maxHeap.empty())
+      throw std::runtime_error("No numbers available");
+
+    if (minHeap.size() > maxHeap.size())
+      return minHeap.top();
+    else
+      return (minHeap.top() + maxHeap.top()) / 2.0;
+  }
+
+private:
+  DAryHeap<double, 4, std::greater<double>> minHeap;
+  DAryHeap<double, 4> maxHeap;
+};
+
 // Alternative (Educational) Solution
 //
 // Uses a multiset to maintain sorted order and an iterator pointing
@@ -182,6 +248,345 @@ private:
   std::multiset<double>::iterator medianIt = data.end();
 };
 
+// Sliding-Window Quantile Tracker
+//
+// The calculators above only grow. Latency monitors want the median (or p95,
+// p99, ...) of the last N samples, so samples must also expire. This tracker
+// keeps the window in arrival order in a ring buffer and in value order in an
+// order-statistic treap (every node stores its subtree size). Treap nodes
+// live in a pool sized to the window up front and are recycled through a
+// free list, so steady-state pushes do not allocate.
+//
+// Quantiles use linear interpolation between the closest ranks, so
+// quantile(0.5) matches getMedian() of the calculators above.
+//
+// Time Complexity:
+// - push(): O(log N) expected (one insert plus at most one erase).
+// - quantile(): O(log N) expected, for any q in [0, 1].
+//
+// Space Complexity:
+// - O(N) for a window of N samples.
+class WindowedQuantileTracker {
+public:
+  explicit WindowedQuantileTracker(size_t windowSize)
+      : window(windowSize), ring(windowSize) {
+    if (windowSize == 0)
+      throw std::invalid_argument("Window size must be positive");
+    nodes.reserve(windowSize + 1);
+  }
+
+  void push(double num) {
+    if (count == window) {
+      root = eraseOne(root, ring[head]);
+      head = (head + 1) % window;
+      --count;
+    }
+    ring[(head + count) % window] = num;
+    ++count;
+    root = insert(root, allocate(num));
+  }
+
+  size_t size() const { return count; }
+
+  double quantile(double q) const {
+    if (count == 0)
+      throw std::runtime_error("No numbers available");
+    if (q < 0.0 || q > 1.0)
+      throw std::invalid_argument("Quantile must be in [0, 1]");
+
+    double position = q * static_cast<double>(count - 1);
+    size_t lower = static_cast<size_t>(std::floor(position));
+    size_t upper = std::min(lower + 1, count - 1);
+    double lowValue = kth(lower);
+    if (upper == lower)
+      return lowValue;
+    double fraction = position - static_cast<double>(lower);
+    return lowValue + fraction * (kth(upper) - lowValue);
+  }
+
+  double getMedian() const { return quantile(0.5); }
+
+private:
+  static constexpr int None = -1;
+
+  struct Node {
+    double key;
+    uint32_t priority;
+    int left;
+    int right;
+    size_t size;
+  };
+
+  size_t sizeOf(int node) const { return node == None ? 0 : nodes[node].size; }
+
+  void update(int node) {
+    nodes[node].size =
+        1 + sizeOf(nodes[node].left) + sizeOf(nodes[node].right);
+  }
+
+  uint32_t nextPriority() {
+    // xorshift32: cheap and good enough to keep the treap balanced.
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+  }
+
+  int allocate(double key) {
+    int node;
+    if (!freeList.empty()) {
+      node = freeList.back();
+      freeList.pop_back();
+    } else {
+      node = static_cast<int>(nodes.size());
+      nodes.push_back({});
+    }
+    nodes[node] = {key, nextPriority(), None, None, 1};
+    return node;
+  }
+
+  // Splits by key: left gets keys < key, right gets keys >= key.
+  void split(int node, double key, int &left, int &right) {
+    if (node == None) {
+      left = right = None;
+      return;
+    }
+    if (nodes[node].key < key) {
+      split(nodes[node].right, key, nodes[node].right, right);
+      left = node;
+    } else {
+      split(nodes[node].left, key, left, nodes[node].left);
+      right = node;
+    }
+    update(node);
+  }
+
+  // Splits off the first `leftSize` nodes in order.
+  void splitBySize(int node, size_t leftSize, int &left, int &right) {
+    if (node == None) {
+      left = right = None;
+      return;
+    }
+    if (sizeOf(nodes[node].left) < leftSize) {
+      splitBySize(nodes[node].right, leftSize - sizeOf(nodes[node].left) - 1,
+                  nodes[node].right, right);
+      left = node;
+    } else {
+      splitBySize(nodes[node].left, leftSize, left, nodes[node].left);
+      right = node;
+    }
+    update(node);
+  }
+
+  int merge(int left, int right) {
+    if (left == None)
+      return right;
+    if (right == None)
+      return left;
+    if (nodes[left].priority > nodes[right].priority) {
+      nodes[left].right = merge(nodes[left].right, right);
+      update(left);
+      return left;
+    }
+    nodes[right].left = merge(left, nodes[right].left);
+    update(right);
+    return right;
+  }
+
+  int insert(int node, int fresh) {
+    int left, right;
+    split(node, nodes[fresh].key, left, right);
+    return merge(merge(left, fresh), right);
+  }
+
+  int eraseOne(int node, double key) {
+    int left, right, match;
+    split(node, key, left, right);
+    // The smallest key in `right` is `key` because the sample is in the window.
+    splitBySize(right, 1, match, right);
+    freeList.push_back(match);
+    return merge(left, right);
+  }
+
+  double kth(size_t k) const {
+    int node = root;
+    while (true) {
+      size_t leftSize = sizeOf(nodes[node].left);
+      if (k < leftSize) {
+        node = nodes[node].left;
+      } else if (k == leftSize) {
+        return nodes[node].key;
+      } else {
+        k -= leftSize + 1;
+        node = nodes[node].right;
+      }
+    }
+  }
+
+  size_t window;
+  std::vector<double> ring;
+  size_t head = 0;
+  size_t count = 0;
+  std::vector<Node> nodes;
+  std::vector<int> freeList;
+  int root = None;
+  uint32_t seed = 2463534242u;
+};
+
+// Approximate Quantile Sketch (KLL)
+//
+// Every calculator above retains all samples. For long-running collectors
+// this sketch (Karnin, Lang, Liberty) keeps a bounded number of samples in a
+// stack of "compactors". Level h holds items of weight 2^h; when a level
+// overflows it is sorted and every other item (random offset) is promoted to
+// the next level, halving its weight count while roughly preserving ranks.
+// Lower levels get geometrically smaller capacities, so total memory is
+// O(k) items plus a logarithmic number of levels.
+//
+// The parameter k controls accuracy: the normalized rank error of a quantile
+// is about 1.7 / k with high probability (k = 200 gives ~1%).
+//
+// Sketches are mergeable: each ingest thread can own one and a collector
+// merges them periodically; the result has the same error guarantee as a
+// single sketch fed with the union of the streams.
+//
+// Time Complexity:
+// - insert(): O(1) amortized (compactions are rare and linear in level size).
+// - quantile(): O(k log k) to sort the retained weighted items.
+// - merge(): O(k log k).
+//
+// Space Complexity:
+// - O(k + log(n / k)) items, independent of the stream length.
+class KllQuantileSketch {
+public:
+  explicit KllQuantileSketch(size_t k = 200, uint64_t seed = 0x9E3779B97F4A7C15)
+      : k(k), rng(seed ? seed : 1) {
+    if (k < 8)
+      throw std::invalid_argument("Sketch parameter k must be at least 8");
+    grow();
+  }
+
+  void insert(double num) {
+    levels[0].push_back(num);
+    ++retained;
+    ++count;
+    if (retained >= maxRetained)
+      compress();
+  }
+
+  void merge(const KllQuantileSketch &other) {
+    while (levels.size() < other.levels.size())
+      grow();
+    for (size_t h = 0; h < other.levels.size(); ++h) {
+      levels[h].insert(levels[h].end(), other.levels[h].begin(),
+                       other.levels[h].end());
+    }
+    retained += other.retained;
+    count += other.count;
+    while (retained >= maxRetained)
+      compress();
+  }
+
+  uint64_t size() const { return count; }
+
+  size_t retainedItems() const { return retained; }
+
+  size_t memoryBytes() const {
+    size_t bytes = sizeof(*this);
+    for (const auto &level : levels)
+      bytes += sizeof(level) + level.capacity() * sizeof(double);
+    return bytes;
+  }
+
+  // Returns the smallest retained item whose weighted rank reaches q * n.
+  double quantile(double q) const {
+    if (count == 0)
+      throw std::runtime_error("No numbers available");
+    if (q < 0.0 || q > 1.0)
+      throw std::invalid_argument("Quantile must be in [0, 1]");
+
+    std::vector<std::pair<double, uint64_t>> weighted;
+    weighted.reserve(retained);
+    for (size_t h = 0; h < levels.size(); ++h) {
+      for (double item : levels[h])
+        weighted.emplace_back(item, uint64_t{1} << h);
+    }
+    std::sort(weighted.begin(), weighted.end());
+
+    uint64_t total = 0;
+    for (const auto &entry : weighted)
+      total += entry.second;
+    const double target = q * static_cast<double>(total);
+
+    uint64_t cumulative = 0;
+    for (const auto &entry : weighted) {
+      cumulative += entry.second;
+      if (static_cast<double>(cumulative) >= target)
+        return entry.first;
+    }
+    return weighted.back().first;
+  }
+
+  double getMedian() const { return quantile(0.5); }
+
+private:
+  size_t capacity(size_t h) const {
+    // Level capacities shrink by 2/3 per level below the top one.
+    const size_t depth = levels.size() - h - 1;
+    double scaled = static_cast<double>(k) * std::pow(2.0 / 3.0, depth);
+    return static_cast<size_t>(std::ceil(scaled)) + 1;
+  }
+
+  void grow() {
+    levels.emplace_back();
+    maxRetained = 0;
+    for (size_t h = 0; h < levels.size(); ++h)
+      maxRetained += capacity(h);
+  }
+
+  bool coinFlip() {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return rng & 1;
+  }
+
+  void compress() {
+    for (size_t h = 0; h < levels.size(); ++h) {
+      if (levels[h].size() < capacity(h))
+        continue;
+      if (h + 1 == levels.size())
+        grow();
+
+      auto &level = levels[h];
+      std::sort(level.begin(), level.end());
+      // With an odd size the largest item stays behind at this level.
+      const bool keepLast = level.size() % 2 == 1;
+      const double last = level.back();
+      const size_t usable = keepLast ? level.size() - 1 : level.size();
+
+      auto &next = levels[h + 1];
+      for (size_t i = coinFlip() ? 1 : 0; i < usable; i += 2)
+        next.push_back(level[i]);
+
+      retained -= usable / 2;
+      level.clear();
+      if (keepLast)
+        level.push_back(last);
+
+      if (retained < maxRetained)
+        break;
+    }
+  }
+
+  size_t k;
+  uint64_t rng;
+  std::vector<std::vector<double>> levels;
+  size_t retained = 0;
+  size_t maxRetained = 0;
+  uint64_t count = 0;
+};
+
 namespace {
 struct TestRunner {
   int total = 0;
@@ -199,6 +604,16 @@ struct TestRunner {
               << " got=" << toString(got) << "\n";
   }
 
+  void expectTrue(bool condition, const std::string &label) {
+    ++total;
+    if (condition) {
+      std::cout << "[PASS] " << label << "\n";
+      return;
+    }
+    ++failed;
+    std::cout << "[FAIL] " << label << "\n";
+  }
+
   void summary() const {
     std::cout << "Tests: " << total - failed << " passed, " << failed
               << " failed, " << total << " total\n";
@@ -211,6 +626,27 @@ private:
     return oss.str();
   }
 };
+
+// Reference quantile of the last `window` samples by sorting a copy.
+double bruteWindowQuantile(const std::vector<double> &samples, size_t end,
+                           size_t window, double q) {
+  size_t begin = end > window ? end - window : 0;
+  std::vector<double> sorted(samples.begin() + begin, samples.begin() + end);
+  std::sort(sorted.begin(), sorted.end());
+  double position = q * static_cast<double>(sorted.size() - 1);
+  size_t lower = static_cast<size_t>(std::floor(position));
+  size_t upper = std::min(lower + 1, sorted.size() - 1);
+  return sorted[lower] +
+         (position - static_cast<double>(lower)) *
+             (sorted[upper] - sorted[lower]);
+}
+
+// Fraction of `sorted` that is <= value.
+double normalizedRank(const std::vector<double> &sorted, double value) {
+  auto it = std::upper_bound(sorted.begin(), sorted.end(), value);
+  return static_cast<double>(it - sorted.begin()) /
+         static_cast<double>(sorted.size());
+}
 } // namespace
 
 // Test cases for correctness
@@ -226,12 +662,14 @@ void test() {
 
   SimpleMedianCalculator simpleCalc;
   OptimalMedianCalculator optimalCalc;
+  DAryHeapMedianCalculator dAryCalc;
   AlternativeMedianCalculator alternativeCalc;
   TestRunner runner;
 
   for (size_t i = 0; i < inputs.size(); ++i) {
     simpleCalc.insert(inputs[i]);
     optimalCalc.insert(inputs[i]);
+    dAryCalc.insert(inputs[i]);
     alternativeCalc.insert(inputs[i]);
     double m1 = simpleCalc.getMedian();
     double m2 = optimalCalc.getMedian();
@@ -242,12 +680,174 @@ void test() {
                       "optimal median step " + std::to_string(i + 1));
     runner.expectNear(m3, expectedMedians[i], 1e-7,
                       "alternative median step " + std::to_string(i + 1));
+    runner.expectNear(dAryCalc.getMedian(), expectedMedians[i], 1e-7,
+                      "d-ary heap median step " + std::to_string(i + 1));
+  }
+
+  // Sliding window of 3 over the same stream:
+  // [5] -> 5, [5,2] -> 3.5, [5,2,3] -> 3, [2,3,8] -> 3, [3,8,1] -> 3
+  std::vector<double> expectedWindowMedians = {5, 3.5, 3, 3, 3};
+  WindowedQuantileTracker windowed(3);
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    windowed.push(inputs[i]);
+    runner.expectNear(windowed.getMedian(), expectedWindowMedians[i], 1e-7,
+                      "windowed median step " + std::to_string(i + 1));
+  }
+
+  // Random streams with duplicates, checked against sorting the window.
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<int> dist(0, 50);
+  for (size_t window : {1u, 2u, 17u, 100u}) {
+    std::vector<double> samples;
+    WindowedQuantileTracker tracker(window);
+    bool allMatch = true;
+    for (int i = 0; i < 1000; ++i) {
+      samples.push_back(dist(rng));
+      tracker.push(samples.back());
+      for (double q : {0.0, 0.25, 0.5, 0.95, 0.99, 1.0}) {
+        double expected =
+            bruteWindowQuantile(samples, samples.size(), window, q);
+        allMatch = allMatch && std::fabs(tracker.quantile(q) - expected) < 1e-9;
+      }
+    }
+    runner.expectTrue(allMatch, "windowed quantiles vs brute force, window=" +
+                                    std::to_string(window));
+  }
+
+  // KLL sketch: exact while nothing has been compacted yet.
+  KllQuantileSketch smallSketch;
+  for (double v : inputs)
+    smallSketch.insert(v);
+  runner.expectNear(smallSketch.getMedian(), 3, 1e-7, "kll small median");
+
+  // KLL sketch against OptimalMedianCalculator on a long stream.
+  {
+    std::mt19937_64 gen(2024);
+    std::lognormal_distribution<double> latency(0.0, 1.0);
+    const size_t n = 100000;
+    std::vector<double> samples(n);
+    OptimalMedianCalculator exact;
+    DAryHeapMedianCalculator dAry;
+    KllQuantileSketch sketch(200);
+    bool dAryMatches = true;
+    for (auto &v : samples) {
+      v = latency(gen);
+      exact.insert(v);
+      dAry.insert(v);
+      sketch.insert(v);
+      dAryMatches = dAryMatches && dAry.getMedian() == exact.getMedian();
+    }
+    runner.expectTrue(dAryMatches, "d-ary heap median matches optimal");
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    double rankError = std::fabs(normalizedRank(sorted, sketch.getMedian()) -
+                                 normalizedRank(sorted, exact.getMedian()));
+    runner.expectTrue(rankError < 0.02, "kll median rank error vs optimal");
+    double p99Error =
+        std::fabs(normalizedRank(sorted, sketch.quantile(0.99)) - 0.99);
+    runner.expectTrue(p99Error < 0.02, "kll p99 rank error");
+    runner.expectTrue(sketch.retainedItems() < 1000,
+                      "kll retained items stay bounded");
+
+    // Per-thread sketches merged at the end.
+    const size_t threads = 4;
+    std::vector<KllQuantileSketch> partial;
+    for (size_t t = 0; t < threads; ++t)
+      partial.emplace_back(200, t + 1);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&, t] {
+        for (size_t i = t; i < n; i += threads)
+          partial[t].insert(samples[i]);
+      });
+    }
+    for (auto &w : workers)
+      w.join();
+    KllQuantileSketch merged(200);
+    for (const auto &p : partial)
+      merged.merge(p);
+
+    runner.expectTrue(merged.size() == n, "kll merged count");
+    double mergedError =
+        std::fabs(normalizedRank(sorted, merged.getMedian()) - 0.5);
+    runner.expectTrue(mergedError < 0.02, "kll merged median rank error");
   }
 
   runner.summary();
 }
 
+// Cost of keeping p50/p95/p99 over a sliding window. Pass larger sizes (e.g.
+// 10^7 samples, windows up to 10^6) for production-scale numbers.
+void benchmarkWindowedQuantiles(size_t samples,
+                                const std::vector<size_t> &windows) {
+  std::mt19937_64 rng(99);
+  std::lognormal_distribution<double> latency(0.0, 1.0);
+  std::vector<double> stream(samples);
+  for (auto &v : stream)
+    v = latency(rng);
+
+  std::cout << "\nWindowed quantile tracker, " << samples << " samples\n";
+  for (size_t window : windows) {
+    WindowedQuantileTracker tracker(window);
+    double checksum = 0.0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < stream.size(); ++i) {
+      tracker.push(stream[i]);
+      if ((i & 1023) == 0) {
+        checksum += tracker.quantile(0.5) + tracker.quantile(0.95) +
+                    tracker.quantile(0.99);
+      }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() /
+                static_cast<double>(samples);
+    std::cout << "  window=" << std::setw(8) << window << "  " << std::fixed
+              << std::setprecision(1) << ns << " ns/push"
+              << "  (checksum " << std::setprecision(3) << checksum << ")\n";
+  }
+}
+
+// Insert cost and footprint of the KLL sketch versus the exact two-heap
+// calculator, which has to keep every sample.
+void benchmarkQuantileSketch(size_t samples) {
+  std::mt19937_64 rng(7);
+  std::lognormal_distribution<double> latency(0.0, 1.0);
+  std::vector<double> stream(samples);
+  for (auto &v : stream)
+    v = latency(rng);
+
+  auto nsPerInsert = [&](auto &calculator) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (double v : stream)
+      calculator.insert(v);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() /
+           static_cast<double>(samples);
+  };
+
+  std::cout << "\nQuantile sketch, " << samples << " samples\n";
+  OptimalMedianCalculator exact;
+  double exactNs = nsPerInsert(exact);
+  std::cout << "  two heaps      " << std::fixed << std::setprecision(1)
+            << exactNs << " ns/insert, ~" << samples * sizeof(double) / 1024
+            << " KiB\n";
+  DAryHeapMedianCalculator dAry;
+  dAry.reserve(samples);
+  std::cout << "  4-ary heaps    " << nsPerInsert(dAry) << " ns/insert\n";
+  for (size_t k : {100, 200, 800}) {
+    KllQuantileSketch sketch(k);
+    double ns = nsPerInsert(sketch);
+    std::cout << "  kll k=" << std::setw(4) << k << "     " << ns
+              << " ns/insert, " << sketch.memoryBytes() / 1024.0
+              << " KiB, median=" << std::setprecision(4)
+              << sketch.getMedian() << std::setprecision(1) << "\n";
+  }
+}
+
 int main() {
   test();
+  benchmarkWindowedQuantiles(200000, {100, 10000, 100000});
+  benchmarkQuantileSketch(1000000);
   return 0;
 }
@@ -16,8 +16,15 @@
  * Output: 13
  */
 
+#include "../2_Strings/big_uint.h"
+
 #include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -75,6 +82,97 @@ long long alternativeSolution(unsigned int n) {
   return result.a;
 }
 
+// Fast Doubling, generic over the number type
+// Complexity: O(log n) ring operations, using
+//   F(2k)     = F(k) * (2 F(k+1) - F(k))
+//   F(2k + 1) = F(k)^2 + F(k+1)^2
+// A ring supplies Value, fromInt, add, sub and mul. sub(x, y) is only called
+// with x = 2 F(k+1) >= y = F(k), so unsigned types never go negative.
+
+// Modulus below 2^32: every product fits in 64 bits.
+struct Mod64Ring {
+  using Value = uint64_t;
+  uint64_t m;
+  explicit Mod64Ring(uint64_t modulus) : m(modulus) {
+    if (modulus == 0 || modulus > (uint64_t{1} << 32))
+      throw std::invalid_argument("Mod64Ring needs 0 < m <= 2^32.");
+  }
+  Value fromInt(uint64_t v) const { return v % m; }
+  Value add(Value x, Value y) const { return (x + y) % m; }
+  Value sub(Value x, Value y) const { return (x + m - y) % m; }
+  Value mul(Value x, Value y) const { return x * y % m; }
+};
+
+// Any 64-bit modulus: products are formed in 128 bits.
+struct Mod128Ring {
+  using Value = uint64_t;
+  uint64_t m;
+  explicit Mod128Ring(uint64_t modulus) : m(modulus) {
+    if (modulus == 0)
+      throw std::invalid_argument("Modulus must be positive.");
+  }
+  Value fromInt(uint64_t v) const { return v % m; }
+  Value add(Value x, Value y) const {
+    return static_cast<Value>((static_cast<unsigned __int128>(x) + y) % m);
+  }
+  Value sub(Value x, Value y) const {
+    return static_cast<Value>((static_cast<unsigned __int128>(x) + m - y) % m);
+  }
+  Value mul(Value x, Value y) const {
+    return static_cast<Value>(static_cast<unsigned __int128>(x) * y % m);
+  }
+};
+
+// Exact values; with parallel = true large products use the threaded NTT.
+struct BigRing {
+  using Value = BigUInt;
+  bool parallel = false;
+  Value fromInt(uint64_t v) const { return BigUInt(v); }
+  Value add(const Value &x, const Value &y) const { return x + y; }
+  Value sub(const Value &x, const Value &y) const { return x - y; }
+  Value mul(const Value &x, const Value &y) const {
+    BigUInt out;
+    BigUInt::multiply(x, y, out, BigUInt::MulAlgorithm::Auto, parallel);
+    return out;
+  }
+};
+
+template <typename Ring>
+typename Ring::Value fastDoubling(uint64_t n, const Ring &ring) {
+  using Value = typename Ring::Value;
+  Value a = ring.fromInt(0), b = ring.fromInt(1); // F(k), F(k + 1), k = 0
+  for (int bit = std::bit_width(n) - 1; bit >= 0; --bit) {
+    const bool odd = (n >> bit) & 1;
+    if (bit == 0) {
+      // Last step: only F(n) is needed, which saves one or two products.
+      return odd ? ring.add(ring.mul(a, a), ring.mul(b, b))
+                 : ring.mul(a, ring.sub(ring.add(b, b), a));
+    }
+    Value c = ring.mul(a, ring.sub(ring.add(b, b), a)); // F(2k)
+    Value d = ring.add(ring.mul(a, a), ring.mul(b, b)); // F(2k + 1)
+    if (odd) {
+      b = ring.add(c, d);
+      a = std::move(d);
+    } else {
+      a = std::move(c);
+      b = std::move(d);
+    }
+  }
+  return a; // n == 0
+}
+
+// F(n) mod m for any n and m > 0.
+uint64_t fibonacciMod(uint64_t n, uint64_t m) {
+  if (m <= (uint64_t{1} << 32))
+    return fastDoubling(n, Mod64Ring(m));
+  return fastDoubling(n, Mod128Ring(m));
+}
+
+// Exact F(n).
+BigUInt fibonacciBig(uint64_t n, bool parallel = false) {
+  return fastDoubling(n, BigRing{parallel});
+}
+
 namespace {
 struct TestRunner {
   int total = 0;
@@ -92,6 +190,16 @@ struct TestRunner {
               << " got=" << got << "\n";
   }
 
+  void expectTrue(bool condition, const std::string &label) {
+    ++total;
+    if (condition) {
+      std::cout << "[PASS] " << label << "\n";
+      return;
+    }
+    ++failed;
+    std::cout << "[FAIL] " << label << "\n";
+  }
+
   void summary() const {
     std::cout << "Tests: " << total - failed << " passed, " << failed
               << " failed, " << total << " total\n";
@@ -118,13 +226,78 @@ void test() {
     runner.expectEqual(optimal, alternative,
                        "optimal == alternative n=" + std::to_string(n));
 
+    runner.expectTrue(fibonacciBig(n).toString() == std::to_string(optimal),
+                      "fibonacciBig == optimal n=" + std::to_string(n));
+
     std::cout << "Fibonacci(" << n << ") = " << optimal << std::endl;
   }
 
+  // Past F(92) long long overflows; the big backend stays exact.
+  runner.expectTrue(fibonacciBig(100).toString() == "354224848179261915075",
+                    "fibonacciBig n=100");
+  BigUInt f1000 = fibonacciBig(1000), f1001 = fibonacciBig(1001);
+  runner.expectTrue(fibonacciBig(1002) == f1000 + f1001,
+                    "fibonacciBig recurrence n=1002");
+
+  // Modular backends agree with each other and with the exact value.
+  const uint64_t mersenne61 = (uint64_t{1} << 61) - 1;
+  for (uint64_t n : std::vector<uint64_t>{0, 1, 93, 5000, 123457}) {
+    BigUInt exact = fibonacciBig(n, n > 100000);
+    for (uint64_t m :
+         std::vector<uint64_t>{10, 1000000007, 4294967296, mersenne61}) {
+      uint64_t viaMod128 = fastDoubling(n, Mod128Ring(m));
+      bool agree = viaMod128 == exact.mod(m) && fibonacciMod(n, m) == viaMod128;
+      if (m <= (uint64_t{1} << 32))
+        agree = agree && fastDoubling(n, Mod64Ring(m)) == viaMod128;
+      runner.expectTrue(agree, "mod backends n=" + std::to_string(n) +
+                                   " m=" + std::to_string(m));
+    }
+  }
+
+  // Huge n: F(n) mod 10 has period 60, and F(40) = 102334155.
+  runner.expectEqual(
+      static_cast<long long>(fibonacciMod(1000000000000000000ull, 10)), 5,
+      "fibonacciMod n=10^18 m=10");
+
   runner.summary();
 }
 
+// Time to produce F(n) exactly, sequentially and with the parallel NTT, plus
+// the iterative O(n) big-number loop for comparison on a smaller n.
+void benchmarkFibonacci(uint64_t n) {
+  auto ms = [](auto &&fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+  };
+  BigUInt sequential, parallel;
+  double tSeq = ms([&] { sequential = fibonacciBig(n, false); });
+  double tPar = ms([&] { parallel = fibonacciBig(n, true); });
+  std::string digits;
+  double tFormat = ms([&] { digits = sequential.toString(); });
+
+  const uint64_t small = std::min<uint64_t>(n, 20000);
+  BigUInt a(0), b(1);
+  double tLoop = ms([&] {
+    for (uint64_t i = 0; i < small; ++i) {
+      a += b;
+      std::swap(a, b);
+    }
+  });
+
+  std::cout << "\nF(" << n << ") has " << digits.size() << " digits\n"
+            << std::fixed << std::setprecision(1)
+            << "  fast doubling             " << tSeq << " ms\n"
+            << "  fast doubling, parallel   " << tPar << " ms"
+            << (parallel == sequential ? "" : "  MISMATCH") << "\n"
+            << "  toString                  " << tFormat << " ms\n"
+            << "  iterative loop, F(" << small << ")  " << tLoop << " ms"
+            << (a == fibonacciBig(small) ? "" : "  MISMATCH") << "\n";
+}
+
 int main() {
   test();
+  benchmarkFibonacci(10000000);
   return 0;
 }